@@ -0,0 +1,40 @@
+/*
+ * DeferredWork.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include "DeferredWork.h"
+
+/* exclude everything if not used */
+#ifdef MAXDEFERREDWORK
+
+volatile DeferredWork deferredWork_mem[MAXDEFERREDWORK];
+volatile uint8_t deferredWork_head = 0;
+volatile uint8_t deferredWork_tail = 0;
+volatile uint16_t deferredWork_overflows = 0;
+
+void DeferredWork_scheduleTask(void* task)
+{
+    scheduleTask((Task*) task);
+}
+
+void DeferredWork_drain()
+{
+    uint8_t tail = deferredWork_tail;
+
+    while (tail != deferredWork_head)
+    {
+        DeferredFunction* function = deferredWork_mem[tail].function;
+        void* argument = deferredWork_mem[tail].argument;
+
+        // free the entry before the call, the function may take long
+        tail = (tail + 1) & DeferredWork_indexMask;
+        deferredWork_tail = tail;
+
+        function(argument);
+    }
+}
+
+#endif /* MAXDEFERREDWORK */
@@ -0,0 +1,161 @@
+/*
+ * DeferredWork.h
+ *
+ * a queue to defer work from interrupts to the scheduler
+ *
+ * an interrupt posts a function and its argument to a ring buffer.
+ * before it chooses the next task, the scheduler calls the posted functions
+ * in the order they were posted, and it does not go to sleep while work is posted.
+ * every post is called once: two posts of the same work are not merged,
+ * unlike two scheduleTask() of the same task.
+ *
+ * the ring has a single producer and a single consumer:
+ *  - producer: interrupt routines, only the head is written
+ *  - consumer: the scheduler, only the tail is written
+ * without SCHEDULER_PREEMPTIVE interrupt routines do not nest and no interrupts
+ * need to be disabled, to post from a task disable interrupts around DeferredWork_post().
+ * with SCHEDULER_PREEMPTIVE tasks run with interrupts enabled inside of interrupt
+ * routines (schedulerPreempt()), so posts may nest: DeferredWork_post() disables
+ * the interrupts itself with enterCritical() / exitCritical().
+ *
+ * MAXDEFERREDWORK must be a power of two (up to 128), one entry is kept free
+ * to tell a full ring from an empty one.
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef DEFERREDWORK_H_
+#define DEFERREDWORK_H_
+
+#include <RSOSDefines.h>
+
+/* exclude everything if not used */
+#ifdef MAXDEFERREDWORK
+
+#if (MAXDEFERREDWORK & (MAXDEFERREDWORK - 1)) || (MAXDEFERREDWORK > 128)
+#error "MAXDEFERREDWORK must be a power of two, up to 128"
+#endif
+
+#include <stdint.h>
+
+#include "Task.h"
+#include "RSOS_BasicInclude.h"
+
+#ifdef SCHEDULER_PREEMPTIVE
+#include <HardwareAdaptionLayer.h>
+#endif /* SCHEDULER_PREEMPTIVE */
+
+/**
+ * function posted to the queue
+ */
+typedef void (DeferredFunction)(void*);
+
+/**
+ * Deferred work structure
+ * Fields:
+ *  function: the function to call
+ *  argument: the argument the function is called with
+ *
+ * MEMORY:
+ *  this structure takes up 2 pointers
+ */
+typedef struct DeferredWork_t {
+    DeferredFunction* function;
+    void* argument;
+} DeferredWork;
+
+/**
+ * mask for the ring indices
+ */
+#define DeferredWork_indexMask (MAXDEFERREDWORK - 1)
+
+extern volatile DeferredWork deferredWork_mem[MAXDEFERREDWORK];
+
+/**
+ * the next entry to write, only written by the producer
+ */
+extern volatile uint8_t deferredWork_head;
+
+/**
+ * the next entry to call, only written by the consumer
+ */
+extern volatile uint8_t deferredWork_tail;
+
+/**
+ * number of posts rejected because the ring was full
+ */
+extern volatile uint16_t deferredWork_overflows;
+
+/**
+ * posts work to be done by the scheduler.
+ * to be called in an interrupt routine
+ * @param function: the function to call
+ * @param argument: the argument to call the function with
+ * @return RSOS_ret_ERROR if the ring is full, RSOS_ret_OK otherwise
+ */
+static inline RSOS_ret DeferredWork_post(DeferredFunction* function, void* argument) __attribute__((always_inline));
+static inline RSOS_ret DeferredWork_post(DeferredFunction* function, void* argument)
+{
+    RSOS_ret ret = RSOS_ret_OK;
+#ifdef SCHEDULER_PREEMPTIVE
+    uint16_t interruptState = enterCritical();
+#endif /* SCHEDULER_PREEMPTIVE */
+    uint8_t head = deferredWork_head;
+    uint8_t next = (head + 1) & DeferredWork_indexMask;
+
+    if (next == deferredWork_tail)
+    {
+        deferredWork_overflows += 1;
+        ret = RSOS_ret_ERROR;
+    }
+    else
+    {
+        deferredWork_mem[head].function = function;
+        deferredWork_mem[head].argument = argument;
+        deferredWork_head = next;       // publish the entry after it is written
+    }
+#ifdef SCHEDULER_PREEMPTIVE
+    exitCritical(interruptState);
+#endif /* SCHEDULER_PREEMPTIVE */
+    return ret;
+}
+
+/**
+ * the function posted by DeferredWork_postTask()
+ * @param task: the task to schedule
+ */
+__EXTERN_C
+void DeferredWork_scheduleTask(void* task);
+
+/**
+ * posts the scheduling of a task, the task is scheduled by the scheduler
+ * and not in the interrupt.
+ * to be called in an interrupt routine
+ * @param task: the task to schedule
+ * @return RSOS_ret_ERROR if the ring is full, RSOS_ret_OK otherwise
+ */
+static inline RSOS_ret DeferredWork_postTask(Task* task) __attribute__((always_inline));
+static inline RSOS_ret DeferredWork_postTask(Task* task)
+{
+    return DeferredWork_post(DeferredWork_scheduleTask, task);
+}
+
+/**
+ * @return 1 if work is posted and not yet done
+ */
+static inline RSOS_bool DeferredWork_isPending() __attribute__((always_inline));
+static inline RSOS_bool DeferredWork_isPending()
+{
+    return deferredWork_head != deferredWork_tail;
+}
+
+/**
+ * calls all posted functions, including the ones posted while draining.
+ * called by the scheduler before it chooses the next task
+ */
+__EXTERN_C
+void DeferredWork_drain();
+
+#endif /* MAXDEFERREDWORK */
+#endif /* DEFERREDWORK_H_ */
@@ -0,0 +1,121 @@
+/*
+ * EventGroup.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include "EventGroup.h"
+
+/* exclude everything if not used */
+#ifdef MAXEVENTGROUPS
+
+#include <HardwareAdaptionLayer.h>
+
+EventGroup eventGroup_mem[MAXEVENTGROUPS];
+int8_t eventGroup_size = 0;
+
+EventBinding eventBinding_mem[MAXEVENTBINDINGS];
+int8_t eventBinding_size = 0;
+
+volatile uint16_t eventGroup_pending = 0;
+
+Task* task_eventGroupEvaluate = 0;
+
+/**
+ * the task function: evaluates all groups set from interrupts
+ */
+static void EventGroup_evaluatePending()
+{
+    uint16_t interruptState = enterCritical();
+    uint16_t pending = eventGroup_pending;
+    eventGroup_pending = 0;
+    exitCritical(interruptState);
+
+    int8_t i;
+    for (i=0; pending != 0; i++, pending >>= 1)
+    {
+        if (pending & 0x01)
+        {
+            EventGroup_evaluate(&eventGroup_mem[i]);
+        }
+    }
+}
+
+void initEventGroupOperation()
+{
+    task_eventGroupEvaluate = addTask(EVENTGROUP_PRIORITY, EventGroup_evaluatePending);
+}
+
+EventGroup* initEventGroup()
+{
+    eventGroup_mem[eventGroup_size].flags = 0;
+    eventGroup_mem[eventGroup_size].firstBinding = -1;
+
+    eventGroup_size += 1;
+    return &eventGroup_mem[eventGroup_size - 1];
+}
+
+EventBinding* EventGroup_bind(EventGroup* group, Task* task, uint16_t mask, uint8_t mode)
+{
+    // all flags of an empty mask are always set, EventGroup_waitAll would trigger on every evaluation
+    if (mask == 0)
+    {
+        return 0;
+    }
+    eventBinding_mem[eventBinding_size].mask = mask;
+    eventBinding_mem[eventBinding_size].mode = mode;
+    eventBinding_mem[eventBinding_size].task = getTaskNumber(task);
+    eventBinding_mem[eventBinding_size].next = -1;
+
+    // append, the bindings are evaluated in the order they were bound
+    int8_t* link = &group->firstBinding;
+    while (*link != -1)
+    {
+        link = &eventBinding_mem[*link].next;
+    }
+    *link = eventBinding_size;
+
+    eventBinding_size += 1;
+    return &eventBinding_mem[eventBinding_size - 1];
+}
+
+void EventGroup_evaluate(EventGroup* group)
+{
+    int8_t i;
+    uint16_t interruptState = enterCritical();
+
+    for (i = group->firstBinding; i != -1; i = eventBinding_mem[i].next)
+    {
+        EventBinding* binding = &eventBinding_mem[i];
+        uint16_t flags = group->flags & binding->mask;
+
+        if ((binding->mode & EventGroup_waitAll) ? (flags == binding->mask) : (flags != 0))
+        {
+            if (binding->mode & EventGroup_clearOnTrigger)
+            {
+                group->flags &= ~binding->mask;
+            }
+            scheduleTask(&task_mem[binding->task]);
+        }
+    }
+    exitCritical(interruptState);
+}
+
+void EventGroup_set(EventGroup* group, uint16_t flags)
+{
+    uint16_t interruptState = enterCritical();
+    group->flags |= flags;
+    exitCritical(interruptState);
+
+    EventGroup_evaluate(group);
+}
+
+void EventGroup_clear(EventGroup* group, uint16_t flags)
+{
+    uint16_t interruptState = enterCritical();
+    group->flags &= ~flags;
+    exitCritical(interruptState);
+}
+
+#endif /* MAXEVENTGROUPS */
@@ -0,0 +1,200 @@
+/*
+ * EventGroup.h
+ *
+ * event groups: 16 event flags per group, tasks are bound to a condition on the flags
+ *
+ * a binding activates its task when the condition is true:
+ *  - EventGroup_waitAny: at least one flag of the mask is set
+ *  - EventGroup_waitAll: all flags of the mask are set
+ * with EventGroup_clearOnTrigger, the flags of the mask are cleared when the
+ * binding activates its task, else the task is activated on every evaluation
+ * the condition is true.
+ *
+ * operation:
+ *      1.  initEventGroupOperation() adds the task that evaluates the groups
+ *      2.  initEventGroup() creates a group, EventGroup_bind() binds a task to a condition
+ *      3.  tasks set flags with EventGroup_set(), the bindings are evaluated at once
+ *      4.  interrupts set flags with EventGroup_setFromISR(), this only sets the flags
+ *          and marks the group, the evaluation task evaluates it later
+ *
+ * to operate, the following structures must be available:
+ *      1x Task
+ * the HardwareAdaptionLayer must provide enterCritical() / exitCritical()
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef EVENTGROUP_H_
+#define EVENTGROUP_H_
+
+#include <RSOSDefines.h>
+
+/* exclude everything if not used */
+#ifdef MAXEVENTGROUPS
+
+#if MAXEVENTGROUPS > 16
+#error "MAXEVENTGROUPS must not exceed 16"
+#endif
+
+#ifndef MAXEVENTBINDINGS
+#error "MAXEVENTBINDINGS must be defined with MAXEVENTGROUPS"
+#endif
+
+#include <stdint.h>
+
+#include "Task.h"
+#include "RSOS_BasicInclude.h"
+#include <HardwareAdaptionLayer.h>
+
+#ifndef EVENTGROUP_PRIORITY
+/**
+ * priority of the task that evaluates the groups set from interrupts
+ */
+#define EVENTGROUP_PRIORITY priorityMask
+#endif /* EVENTGROUP_PRIORITY */
+
+/**
+ * Event group structure
+ * Fields:
+ *  flags: the event flags
+ *  firstBinding: the number of the first binding of this group, -1 if none
+ *
+ * MEMORY:
+ *  this structure takes up 3 Bytes
+ */
+typedef struct EventGroup_t {
+    volatile uint16_t flags;
+    int8_t firstBinding;
+} EventGroup;
+
+/**
+ * Event binding structure
+ * Fields:
+ *  mask: the flags of the condition
+ *  mode: bit field:
+ *      xxxx xxCA
+ *      C: clear the flags of the mask when triggered
+ *      A: 1: all flags of the mask must be set, 0: any flag of the mask
+ *  task: the number of the task to activate
+ *  next: the number of the next binding of the same group, -1 at the end
+ *
+ * MEMORY:
+ *  this structure takes up 5 Bytes
+ */
+typedef struct EventBinding_t {
+    uint16_t mask;
+    uint8_t mode;
+    int8_t task;
+    int8_t next;
+} EventBinding;
+
+extern EventGroup eventGroup_mem[MAXEVENTGROUPS];
+extern int8_t eventGroup_size;
+
+extern EventBinding eventBinding_mem[MAXEVENTBINDINGS];
+extern int8_t eventBinding_size;
+
+/**
+ * bit field of the groups set from interrupts and not evaluated yet
+ */
+extern volatile uint16_t eventGroup_pending;
+
+/**
+ * the task evaluating the groups set from interrupts
+ */
+extern Task* task_eventGroupEvaluate;
+
+/**
+ * binding mode: any flag of the mask
+ */
+#define EventGroup_waitAny 0x00
+
+/**
+ * binding mode: all flags of the mask
+ */
+#define EventGroup_waitAll 0x01
+
+/**
+ * binding mode: clear the flags of the mask when the task is activated
+ */
+#define EventGroup_clearOnTrigger 0x02
+
+/**
+ * initializes the event group operation, adds the evaluation task
+ */
+__EXTERN_C
+void initEventGroupOperation();
+
+/**
+ * initializes a new event group, all flags are cleared
+ * @return a reference to the new event group
+ */
+__EXTERN_C
+EventGroup* initEventGroup();
+
+/**
+ * binds a task to a condition on the flags of a group
+ * @param group: the group
+ * @param task: the task to activate
+ * @param mask: the flags of the condition, must not be 0
+ * @param mode: EventGroup_waitAny or EventGroup_waitAll, optionally or'd with EventGroup_clearOnTrigger
+ * @return a reference to the new binding, 0 if the mask is 0
+ */
+__EXTERN_C
+EventBinding* EventGroup_bind(EventGroup* group, Task* task, uint16_t mask, uint8_t mode);
+
+/**
+ * evaluates the bindings of a group and activates the tasks whose condition is true
+ * @param group: the group to evaluate
+ */
+__EXTERN_C
+void EventGroup_evaluate(EventGroup* group);
+
+/**
+ * sets flags and evaluates the bindings of the group.
+ * not to be called in an interrupt routine, @see EventGroup_setFromISR()
+ * @param group: the group
+ * @param flags: the flags to set
+ */
+__EXTERN_C
+void EventGroup_set(EventGroup* group, uint16_t flags);
+
+/**
+ * clears flags of a group
+ * @param group: the group
+ * @param flags: the flags to clear
+ */
+__EXTERN_C
+void EventGroup_clear(EventGroup* group, uint16_t flags);
+
+/**
+ * sets flags in an interrupt routine, constant time.
+ * the bindings are evaluated by the task task_eventGroupEvaluate.
+ * the flags and the mark are set with interrupts disabled, as the interrupt
+ * may be nested (SCHEDULER_PREEMPTIVE) or the function called from a task
+ * @param group: the group
+ * @param flags: the flags to set
+ */
+static inline void EventGroup_setFromISR(EventGroup* group, uint16_t flags) __attribute__((always_inline));
+static inline void EventGroup_setFromISR(EventGroup* group, uint16_t flags)
+{
+    uint16_t interruptState = enterCritical();
+    group->flags |= flags;
+    eventGroup_pending |= 1 << (group - eventGroup_mem);
+    exitCritical(interruptState);
+    scheduleTask(task_eventGroupEvaluate);
+}
+
+/**
+ * @param group: the group
+ * @return the flags of the group
+ */
+static inline uint16_t EventGroup_get(EventGroup* group) __attribute__((always_inline));
+static inline uint16_t EventGroup_get(EventGroup* group)
+{
+    return group->flags;
+}
+
+#endif /* MAXEVENTGROUPS */
+#endif /* EVENTGROUP_H_ */
@@ -0,0 +1,356 @@
+/*
+ * RTC.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include "RTC.h"
+
+/* exclude everything if not used */
+#ifdef MAXRTCALARMS
+
+#include <HardwareAdaptionLayer.h>
+
+RTC_Alarm rtcAlarm_mem[MAXRTCALARMS];
+int8_t rtcAlarm_size = 0;
+
+volatile rtc_time_t rtc_seconds = 0;
+
+/**
+ * the date and time of rtc_seconds, counted along
+ */
+static RTC_DateTime rtc_dateTime;
+
+/**
+ * the ticks counted within the current second, 16 Bit for tick rates above 255 Hz
+ */
+static volatile uint16_t rtc_ticks = 0;
+
+/**
+ * the first alarm in the sorted list, -1 if no alarm is set
+ */
+static volatile int8_t rtc_alarmFirst = -1;
+
+static const uint8_t rtc_daysOfMonth[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+/**
+ * @return 1 if the year is a leap year
+ */
+static inline RSOS_bool RTC_isLeapYear(uint16_t year) __attribute__((always_inline));
+static inline RSOS_bool RTC_isLeapYear(uint16_t year)
+{
+    if (year & 0x03)
+    {
+        return RSOS_bool_false;
+    }
+    // the only years divisible by 100 in range are 2100, 2200, 2300 (not leap years) and 2400
+    if (year == 2100 || year == 2200 || year == 2300)
+    {
+        return RSOS_bool_false;
+    }
+    return RSOS_bool_true;
+}
+
+/**
+ * @return the number of days of the month (1..12) in the year
+ */
+static uint8_t RTC_getDaysOfMonth(uint8_t month, uint16_t year)
+{
+    if (month == 2 && RTC_isLeapYear(year))
+    {
+        return 29;
+    }
+    return rtc_daysOfMonth[month - 1];
+}
+
+/**
+ * counts the date fields one second further
+ */
+static inline void RTC_incrementDateTime() __attribute__((always_inline));
+static inline void RTC_incrementDateTime()
+{
+    if (++rtc_dateTime.second < 60) return;
+    rtc_dateTime.second = 0;
+    if (++rtc_dateTime.minute < 60) return;
+    rtc_dateTime.minute = 0;
+    if (++rtc_dateTime.hour < 24) return;
+    rtc_dateTime.hour = 0;
+
+    if (++rtc_dateTime.weekday == 7)
+    {
+        rtc_dateTime.weekday = 0;
+    }
+    if (++rtc_dateTime.day <= RTC_getDaysOfMonth(rtc_dateTime.month, rtc_dateTime.year)) return;
+    rtc_dateTime.day = 1;
+    if (++rtc_dateTime.month <= 12) return;
+    rtc_dateTime.month = 1;
+    rtc_dateTime.year += 1;
+}
+
+/**
+ * puts an alarm into the list sorted by time.
+ * only to be called with interrupts disabled
+ * @param alarm: the alarm to insert
+ */
+static void RTC_insertAlarm(RTC_Alarm* alarm)
+{
+    int8_t alarmNr = alarm - rtcAlarm_mem;
+    volatile int8_t* link = &rtc_alarmFirst;
+
+    // alarms are compared relative to the current second, so the counter may overflow.
+    // alarms in the past get a negative distance and are due with the next second
+    int32_t distance = (int32_t)(alarm->time - rtc_seconds);
+    while (*link != -1 && (int32_t)(rtcAlarm_mem[*link].time - rtc_seconds) <= distance)
+    {
+        link = &rtcAlarm_mem[*link].next;
+    }
+    alarm->next = *link;
+    *link = alarmNr;
+    alarm->isActive = RSOS_bool_true;
+}
+
+/**
+ * removes an alarm from the sorted list.
+ * only to be called with interrupts disabled
+ * @param alarm: the alarm to remove
+ */
+static void RTC_removeAlarm(RTC_Alarm* alarm)
+{
+    int8_t alarmNr = alarm - rtcAlarm_mem;
+    volatile int8_t* link = &rtc_alarmFirst;
+
+    while (*link != -1 && *link != alarmNr)
+    {
+        link = &rtcAlarm_mem[*link].next;
+    }
+    if (*link == alarmNr)
+    {
+        *link = alarm->next;
+    }
+    alarm->next = -1;
+    alarm->isActive = RSOS_bool_false;
+}
+
+/**
+ * moves a periodic alarm that lies more than one period in the past to its
+ * last due time, so the missed periods are skipped here and RTC_tick()
+ * schedules the alarm once and advances it by one period only.
+ * only to be called with interrupts disabled
+ * @param alarm: the alarm to move, not in the list
+ */
+static void RTC_skipMissedPeriods(RTC_Alarm* alarm)
+{
+    int32_t distance = (int32_t)(alarm->time - rtc_seconds);
+    if (alarm->period != 0 && distance < 0)
+    {
+        alarm->time += ((uint32_t)(-distance) / alarm->period) * alarm->period;
+    }
+}
+
+void RTC_initOperation()
+{
+    RTC_secondsToDateTime(0, &rtc_dateTime);
+    rtc_seconds = 0;
+    rtc_ticks = 0;
+    rtc_alarmFirst = -1;
+}
+
+void RTC_tick()
+{
+    rtc_ticks += 1;
+    if (rtc_ticks < RTC_TICKSPERSECOND)
+    {
+        return;
+    }
+    rtc_ticks = 0;
+
+    rtc_seconds += 1;
+    RTC_incrementDateTime();
+
+    // due alarms: the alarm time lies behind the current second
+    while (rtc_alarmFirst != -1 && (int32_t)(rtcAlarm_mem[rtc_alarmFirst].time - rtc_seconds) <= 0)
+    {
+        RTC_Alarm* alarm = &rtcAlarm_mem[rtc_alarmFirst];
+        RTC_removeAlarm(alarm);
+        if (alarm->task != -1)
+        {
+            scheduleTask(&task_mem[alarm->task]);
+        }
+        if (alarm->period != 0)
+        {
+            // the missed periods are skipped by RTC_setAlarm() and RTC_setSeconds(),
+            // so one period brings the alarm after the current second
+            alarm->time += alarm->period;
+            RTC_insertAlarm(alarm);
+        }
+    }
+}
+
+rtc_time_t RTC_getSeconds()
+{
+    uint16_t interruptState = enterCritical();
+    rtc_time_t seconds = rtc_seconds;
+    exitCritical(interruptState);
+    return seconds;
+}
+
+void RTC_setSeconds(rtc_time_t seconds)
+{
+    RTC_DateTime dateTime;
+    RTC_secondsToDateTime(seconds, &dateTime);
+
+    uint16_t interruptState = enterCritical();
+    rtc_seconds = seconds;
+    rtc_dateTime = dateTime;
+    rtc_ticks = 0;
+
+    // the order of the alarms relative to the new time may have changed
+    int8_t alarms = rtc_alarmFirst;
+    rtc_alarmFirst = -1;
+    while (alarms != -1)
+    {
+        RTC_Alarm* alarm = &rtcAlarm_mem[alarms];
+        alarms = alarm->next;
+        RTC_skipMissedPeriods(alarm);
+        RTC_insertAlarm(alarm);
+    }
+    exitCritical(interruptState);
+}
+
+void RTC_getDateTime(RTC_DateTime* dateTime)
+{
+    uint16_t interruptState = enterCritical();
+    *dateTime = rtc_dateTime;
+    exitCritical(interruptState);
+}
+
+RSOS_ret RTC_setDateTime(const RTC_DateTime* dateTime)
+{
+    if (dateTime->year < RTC_EPOCH_YEAR
+        || dateTime->month < 1 || dateTime->month > 12
+        || dateTime->day < 1 || dateTime->day > RTC_getDaysOfMonth(dateTime->month, dateTime->year)
+        || dateTime->hour > 23 || dateTime->minute > 59 || dateTime->second > 59)
+    {
+        return RSOS_ret_ERROR;
+    }
+    RTC_setSeconds(RTC_dateTimeToSeconds(dateTime));
+    return RSOS_ret_OK;
+}
+
+rtc_time_t RTC_dateTimeToSeconds(const RTC_DateTime* dateTime)
+{
+    uint32_t days = 0;
+    uint16_t year;
+    uint8_t month;
+
+    for (year = RTC_EPOCH_YEAR; year < dateTime->year; year += 1)
+    {
+        days += RTC_isLeapYear(year) ? 366 : 365;
+    }
+    for (month = 1; month < dateTime->month; month += 1)
+    {
+        days += RTC_getDaysOfMonth(month, dateTime->year);
+    }
+    days += dateTime->day - 1;
+
+    return ((days * 24 + dateTime->hour) * 60 + dateTime->minute) * 60 + dateTime->second;
+}
+
+void RTC_secondsToDateTime(rtc_time_t seconds, RTC_DateTime* dateTime)
+{
+    uint32_t secondsOfYear;
+
+    dateTime->year = RTC_EPOCH_YEAR;
+    dateTime->weekday = RTC_EPOCH_WEEKDAY;
+    for (;;)
+    {
+        secondsOfYear = RTC_isLeapYear(dateTime->year) ? 366 * RTC_PERIOD_DAILY : 365 * RTC_PERIOD_DAILY;
+        if (seconds < secondsOfYear)
+        {
+            break;
+        }
+        seconds -= secondsOfYear;
+        // 365 days are 52 weeks and 1 day
+        dateTime->weekday += RTC_isLeapYear(dateTime->year) ? 2 : 1;
+        dateTime->year += 1;
+    }
+
+    dateTime->month = 1;
+    for (;;)
+    {
+        uint32_t secondsOfMonth = RTC_getDaysOfMonth(dateTime->month, dateTime->year) * RTC_PERIOD_DAILY;
+        if (seconds < secondsOfMonth)
+        {
+            break;
+        }
+        seconds -= secondsOfMonth;
+        // 28 days are 4 weeks
+        dateTime->weekday += RTC_getDaysOfMonth(dateTime->month, dateTime->year) - 28;
+        dateTime->month += 1;
+    }
+
+    dateTime->day = 1;
+    while (seconds >= RTC_PERIOD_DAILY)
+    {
+        seconds -= RTC_PERIOD_DAILY;
+        dateTime->day += 1;
+        dateTime->weekday += 1;
+    }
+    while (dateTime->weekday >= 7)
+    {
+        dateTime->weekday -= 7;
+    }
+
+    dateTime->hour = 0;
+    while (seconds >= RTC_PERIOD_HOURLY)
+    {
+        seconds -= RTC_PERIOD_HOURLY;
+        dateTime->hour += 1;
+    }
+    dateTime->minute = 0;
+    while (seconds >= RTC_PERIOD_MINUTELY)
+    {
+        seconds -= RTC_PERIOD_MINUTELY;
+        dateTime->minute += 1;
+    }
+    dateTime->second = seconds;
+}
+
+RTC_Alarm* RTC_initAlarm(Task* task)
+{
+    rtcAlarm_mem[rtcAlarm_size].time = 0;
+    rtcAlarm_mem[rtcAlarm_size].period = 0;
+    rtcAlarm_mem[rtcAlarm_size].task = getTaskNumber(task);
+    rtcAlarm_mem[rtcAlarm_size].next = -1;
+    rtcAlarm_mem[rtcAlarm_size].isActive = RSOS_bool_false;
+
+    rtcAlarm_size += 1;
+    return &rtcAlarm_mem[rtcAlarm_size - 1];
+}
+
+void RTC_setAlarm(RTC_Alarm* alarm, rtc_time_t time, uint32_t period)
+{
+    uint16_t interruptState = enterCritical();
+    if (alarm->isActive)
+    {
+        RTC_removeAlarm(alarm);
+    }
+    alarm->time = time;
+    alarm->period = period;
+    RTC_skipMissedPeriods(alarm);
+    RTC_insertAlarm(alarm);
+    exitCritical(interruptState);
+}
+
+void RTC_clearAlarm(RTC_Alarm* alarm)
+{
+    uint16_t interruptState = enterCritical();
+    if (alarm->isActive)
+    {
+        RTC_removeAlarm(alarm);
+    }
+    exitCritical(interruptState);
+}
+
+#endif /* MAXRTCALARMS */
@@ -0,0 +1,221 @@
+/*
+ * RTC.h
+ *
+ * a software real time clock with calendar and alarms
+ *
+ * the clock is driven by a timer interrupt calling RTC_tick().
+ * it counts the seconds since the epoch (01.01.2000 00:00:00, a saturday)
+ * and keeps the date fields (seconds, minutes, ... year) up to date by
+ * incrementing them once per second, so no division is done in the interrupt.
+ *
+ * alarms are kept in a list sorted by their time, on every second only the first
+ * alarm is checked. When an alarm is due, its task is scheduled. An alarm can repeat
+ * with a period, for example daily or hourly.
+ *
+ * the functions called from tasks use enterCritical() / exitCritical() of the
+ * hardware adaption layer to keep the clock consistent with the interrupt.
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef RTC_H_
+#define RTC_H_
+
+#include <RSOSDefines.h>
+
+/* exclude everything if not used */
+#ifdef MAXRTCALARMS
+
+#include <stdint.h>
+
+#include "Task.h"
+#include "RSOS_BasicInclude.h"
+
+#ifndef RTC_TICKSPERSECOND
+/**
+ * the number of calls to RTC_tick() per second (1 to 65535)
+ */
+#define RTC_TICKSPERSECOND 1
+#endif /* RTC_TICKSPERSECOND */
+
+#if RTC_TICKSPERSECOND < 1 || RTC_TICKSPERSECOND > 65535
+#error "RTC_TICKSPERSECOND must be 1 to 65535"
+#endif
+
+/**
+ * the year of the epoch, second 0 is 01.01. of this year, 00:00:00
+ */
+#define RTC_EPOCH_YEAR 2000
+
+/**
+ * weekday of the epoch (0: monday .. 6: sunday)
+ */
+#define RTC_EPOCH_WEEKDAY 5
+
+/**
+ * alarm period: once every minute
+ */
+#define RTC_PERIOD_MINUTELY 60UL
+
+/**
+ * alarm period: once every hour
+ */
+#define RTC_PERIOD_HOURLY 3600UL
+
+/**
+ * alarm period: once every day
+ */
+#define RTC_PERIOD_DAILY 86400UL
+
+/**
+ * alarm period: once every week
+ */
+#define RTC_PERIOD_WEEKLY 604800UL
+
+/**
+ * seconds since the epoch
+ */
+typedef uint32_t rtc_time_t;
+
+/**
+ * Date and time structure
+ * Fields:
+ *  year: the year (RTC_EPOCH_YEAR..)
+ *  month: the month (1..12)
+ *  day: the day of the month (1..31)
+ *  weekday: the day of the week (0: monday .. 6: sunday), ignored when setting the time
+ *  hour: (0..23)
+ *  minute: (0..59)
+ *  second: (0..59)
+ *
+ * MEMORY:
+ *  this structure takes up 8 Bytes
+ */
+typedef struct RTC_DateTime_t {
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t weekday;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+} RTC_DateTime;
+
+/**
+ * Alarm structure
+ * Fields:
+ *  time: the second the alarm is due
+ *  period: the number of seconds the alarm is repeated after, 0 if the alarm is due once
+ *  task: the number of the task scheduled when the alarm is due
+ *  next: the number of the next alarm in the sorted list, -1 at the end
+ *  isActive: 1 if the alarm is in the list
+ *
+ * MEMORY:
+ *  this structure takes up 11 Bytes
+ */
+typedef struct RTC_Alarm_t {
+    rtc_time_t time;
+    uint32_t period;
+    int8_t task;
+    int8_t next;
+    RSOS_bool isActive;
+} RTC_Alarm;
+
+extern RTC_Alarm rtcAlarm_mem[MAXRTCALARMS];
+extern int8_t rtcAlarm_size;
+
+/**
+ * the seconds since the epoch
+ */
+extern volatile rtc_time_t rtc_seconds;
+
+/**
+ * initializes the real time clock, the time is set to the epoch
+ */
+__EXTERN_C
+void RTC_initOperation();
+
+/**
+ * to be called in a timer interrupt routine, RTC_TICKSPERSECOND times per second.
+ * counts the seconds and the date fields and schedules the tasks of due alarms
+ */
+__EXTERN_C
+void RTC_tick();
+
+/**
+ * @return the seconds since the epoch
+ */
+__EXTERN_C
+rtc_time_t RTC_getSeconds();
+
+/**
+ * sets the clock to the given seconds since the epoch.
+ * the alarms keep their time, alarms that are due are scheduled with the next second.
+ * periodic alarms that are due are scheduled once, the missed periods are skipped
+ * @param seconds: the seconds since the epoch
+ */
+__EXTERN_C
+void RTC_setSeconds(rtc_time_t seconds);
+
+/**
+ * reads the current date and time
+ * @param dateTime: the structure to write to
+ */
+__EXTERN_C
+void RTC_getDateTime(RTC_DateTime* dateTime);
+
+/**
+ * sets the clock to the given date and time
+ * @param dateTime: the date and time to set, the weekday is calculated
+ * @return RSOS_ret_ERROR if the date is before the epoch or invalid, else RSOS_ret_OK
+ */
+__EXTERN_C
+RSOS_ret RTC_setDateTime(const RTC_DateTime* dateTime);
+
+/**
+ * converts a date and time to seconds since the epoch, for example to set an alarm
+ * @param dateTime: the date and time to convert, the weekday is ignored
+ * @return the seconds since the epoch
+ */
+__EXTERN_C
+rtc_time_t RTC_dateTimeToSeconds(const RTC_DateTime* dateTime);
+
+/**
+ * converts seconds since the epoch to a date and time
+ * uses subtraction only, no division
+ * @param seconds: the seconds since the epoch
+ * @param dateTime: the structure to write to
+ */
+__EXTERN_C
+void RTC_secondsToDateTime(rtc_time_t seconds, RTC_DateTime* dateTime);
+
+/**
+ * initializes a new alarm
+ * @param task: the task to schedule when the alarm is due
+ * @return a reference to the new alarm
+ */
+__EXTERN_C
+RTC_Alarm* RTC_initAlarm(Task* task);
+
+/**
+ * sets an alarm. if the alarm is already set, it is moved to the new time.
+ * a periodic alarm with a time in the past is scheduled once with the next second,
+ * the missed periods are skipped
+ * @param alarm: the alarm to set
+ * @param time: the second the alarm is due (seconds since the epoch)
+ * @param period: the number of seconds to repeat the alarm after, 0 to be due only once
+ *        (RTC_PERIOD_DAILY, RTC_PERIOD_HOURLY, ...)
+ */
+__EXTERN_C
+void RTC_setAlarm(RTC_Alarm* alarm, rtc_time_t time, uint32_t period);
+
+/**
+ * removes an alarm, its task is not scheduled anymore
+ * @param alarm: the alarm to remove
+ */
+__EXTERN_C
+void RTC_clearAlarm(RTC_Alarm* alarm);
+
+#endif /* MAXRTCALARMS */
+#endif /* RTC_H_ */
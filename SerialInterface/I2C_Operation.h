@@ -3,6 +3,10 @@
  *
  *  Created on: 12.03.2017
  *      Author: Richard
+ *
+ *  Changelog
+ *  2026 10 18
+ *      records trace events on transfer begin, end and error (if MAXTRACEEVENTS is defined)
  */
 
 #ifndef I2C_OPERATION_H_
@@ -13,6 +17,7 @@
 #ifdef I2CDATASIZE
 
 #include "../buffer/BasicBuffer_int8.h"
+#include "../Trace.h"
 #include <stdint.h>
 
 #include <HardwareAdaptionLayer.h>
@@ -133,6 +138,7 @@ static inline uint8_t I2C_isActive(I2C_Data* data)
 static inline void I2C_error() __attribute__((always_inline));
 static inline void I2C_error()
 {
+    TRACE(TRACE_I2C_ERROR, activeI2CTransmission);
     if (activeI2CTransmission != -1)
     {
         i2c_data_mem[activeI2CTransmission].bytesToRead = 0;
@@ -167,6 +173,7 @@ static inline int8_t I2C_nextByte_ISR_write()
             }
             else
             {
+                TRACE(TRACE_I2C_ERROR, activeI2CTransmission);
                 i2c_data_mem[activeI2CTransmission].slaveAddress &= ~I2C_ISACTIVE;
                 activeI2CTransmission = -1;
             }
@@ -182,6 +189,7 @@ static inline int8_t I2C_nextByte_ISR_write()
         {
             I2C_unsetInterruptFlag(I2C_IFG_TX);
             I2C_setStop();
+            TRACE(TRACE_I2C_END, activeI2CTransmission);
             i2c_data_mem[activeI2CTransmission].slaveAddress &= ~I2C_ISACTIVE;
             activeI2CTransmission = -1;
             return 0;
@@ -214,6 +222,7 @@ static inline int8_t I2C_nextByte_ISR_read()
                 if (i2c_data_mem[activeI2CTransmission].bytesToRead == 0)
                 {
                     I2C_setStop();
+                    TRACE(TRACE_I2C_END, activeI2CTransmission);
                     i2c_data_mem[activeI2CTransmission].slaveAddress &= ~I2C_ISACTIVE;
                     activeI2CTransmission = -1;
                     return 0;
@@ -225,6 +234,7 @@ static inline int8_t I2C_nextByte_ISR_read()
             }
             else
             {
+                TRACE(TRACE_I2C_ERROR, activeI2CTransmission);
                 i2c_data_mem[activeI2CTransmission].slaveAddress &= ~I2C_ISACTIVE;
                 activeI2CTransmission = -1;
             }
@@ -316,6 +326,7 @@ static inline int8_t I2C_activateData(I2C_Data* data, uint8_t bytesToWrite, uint
         }
 
         activeI2CTransmission = data - i2c_data_mem;
+        TRACE(TRACE_I2C_BEGIN, activeI2CTransmission);
         data->bytesToRead = bytesToRead;
         data->bytesToWrite = bytesToWrite;
 
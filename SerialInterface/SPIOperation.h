@@ -17,6 +17,8 @@
  *      add noRead to strobeOperation, bytes in the buffer are not overwritten by received bytes
  *  2017 04 26
  *      no mixed read write possible, split up interrupts, changed some bits
+ *  2026 10 18
+ *      records trace events on transfer begin and end (if MAXTRACEEVENTS is defined)
  */
 
 #ifndef SHIFTREGISTEROPERATION_H_
@@ -248,6 +250,7 @@ static inline int8_t SPI_changeWriteOperation(SPIOperation* spiop, uint8_t enabl
 static inline void SPI_scheduleStrobe() __attribute__((always_inline));
 static inline void SPI_scheduleStrobe()
 {
+    TRACE(TRACE_SPI_END, g_SPI_activeTransmission);
     if (spiOperation_mem[g_SPI_activeTransmission].operationMode & STROBE_ON_TRANSFER_END)
     {
         scheduleTask(g_SPI_task_strobeSet);
@@ -379,6 +382,7 @@ static inline int8_t SPI_activateSPIOperation(SPIOperation* sr, uint8_t bytesToP
     if (g_SPI_activeTransmission == -1)
     {
         g_SPI_activeTransmission = sr - spiOperation_mem;
+        TRACE(TRACE_SPI_BEGIN, g_SPI_activeTransmission);
         sr->bytesToWrite = bytesToProcess;
         if (sr->operationMode & SPI_READ)
         {
@@ -0,0 +1,62 @@
+/*
+ * Stopwatch.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include "Stopwatch.h"
+
+/* exclude everything if not used */
+#ifdef MAXSTOPWATCHES
+
+Stopwatch stopwatch_mem[MAXSTOPWATCHES];
+int8_t stopwatch_size = 0;
+
+Stopwatch* initStopwatch()
+{
+    Stopwatch_reset(&stopwatch_mem[stopwatch_size]);
+
+    stopwatch_size += 1;
+    return &stopwatch_mem[stopwatch_size - 1];
+}
+
+void Stopwatch_reset(Stopwatch* sw)
+{
+    sw->start = 0;
+    sw->min = 0;
+    sw->max = 0;
+    sw->sum = 0;
+    sw->count = 0;
+    sw->isRunning = RSOS_bool_false;
+}
+
+void Stopwatch_record(Stopwatch* sw, stopwatch_t time)
+{
+    // stop accumulating before the count overflows, the mean stays valid
+    if (sw->count == 0xFFFF)
+    {
+        return;
+    }
+    if (sw->count == 0 || time < sw->min)
+    {
+        sw->min = time;
+    }
+    if (time > sw->max)
+    {
+        sw->max = time;
+    }
+    sw->sum += time;
+    sw->count += 1;
+}
+
+stopwatch_t Stopwatch_getMean(Stopwatch* sw)
+{
+    if (sw->count == 0)
+    {
+        return 0;
+    }
+    return (stopwatch_t)(sw->sum / sw->count);
+}
+
+#endif /* MAXSTOPWATCHES */
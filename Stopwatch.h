@@ -0,0 +1,193 @@
+/*
+ * Stopwatch.h
+ *
+ * a stopwatch to measure the time a piece of code takes,
+ * for example a task, an interrupt routine or a serial transfer
+ *
+ * the stopwatch reads a free running counter from the hardware adaption layer:
+ *  uint16_t getFreeRunningCounter() (uint32_t with STOPWATCH_32BIT)
+ * the counter counts up and overflows, one measurement must not take longer
+ * than one period of the counter
+ *
+ * operation:
+ *      1.  Stopwatch_start() saves the counter
+ *      2.  Stopwatch_lap() measures the time since start or the last lap,
+ *          the stopwatch keeps running
+ *      3.  Stopwatch_stop() measures the time since start or the last lap,
+ *          the stopwatch is stopped
+ * every measured time is accumulated: the minimum, maximum, sum and number
+ * of measurements are kept, the mean is calculated only when read
+ *
+ * Compile flags:
+ *  STOPWATCH_32BIT: the free running counter is 32 bit wide (default 16 bit)
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef STOPWATCH_H_
+#define STOPWATCH_H_
+
+#include <RSOSDefines.h>
+
+/* exclude everything if not used */
+#ifdef MAXSTOPWATCHES
+
+#include <stdint.h>
+
+#include "RSOS_BasicInclude.h"
+
+#ifdef STOPWATCH_32BIT
+/**
+ * type of the free running counter and the measured times
+ */
+typedef uint32_t stopwatch_t;
+
+/**
+ * type of the sum of the measured times
+ */
+typedef uint64_t stopwatchsum_t;
+#else
+typedef uint16_t stopwatch_t;
+typedef uint32_t stopwatchsum_t;
+#endif /* STOPWATCH_32BIT */
+
+#include <HardwareAdaptionLayer.h>
+
+/**
+ * Stopwatch structure
+ * Fields:
+ *  start: the counter at start or at the last lap
+ *  min: the shortest measured time
+ *  max: the longest measured time
+ *  sum: the sum of all measured times
+ *  count: the number of measured times
+ *  isRunning: 1 if the stopwatch is started
+ *
+ * MEMORY:
+ *  this structure takes up 14 Bytes (24 Bytes with STOPWATCH_32BIT), including 1 Byte of padding
+ */
+typedef struct Stopwatch_t {
+    stopwatch_t start;
+    stopwatch_t min;
+    stopwatch_t max;
+    stopwatchsum_t sum;
+    uint16_t count;
+    RSOS_bool isRunning;
+} Stopwatch;
+
+extern Stopwatch stopwatch_mem[MAXSTOPWATCHES];
+extern int8_t stopwatch_size;
+
+/**
+ * initializes a new stopwatch
+ * @return a reference to the new stopwatch
+ */
+__EXTERN_C
+Stopwatch* initStopwatch();
+
+/**
+ * clears the accumulated times of a stopwatch and stops it
+ * @param sw: the stopwatch to clear
+ */
+__EXTERN_C
+void Stopwatch_reset(Stopwatch* sw);
+
+/**
+ * adds a measured time to the accumulated times
+ * @param sw: the stopwatch
+ * @param time: the measured time
+ */
+__EXTERN_C
+void Stopwatch_record(Stopwatch* sw, stopwatch_t time);
+
+/**
+ * starts the stopwatch
+ * @param sw: the stopwatch to start
+ */
+static inline void Stopwatch_start(Stopwatch* sw) __attribute__((always_inline));
+static inline void Stopwatch_start(Stopwatch* sw)
+{
+    sw->isRunning = RSOS_bool_true;
+    sw->start = getFreeRunningCounter();
+}
+
+/**
+ * measures the time since start or the last lap, the stopwatch keeps running
+ * @param sw: the stopwatch
+ * @return the measured time, 0 if the stopwatch is not running
+ */
+static inline stopwatch_t Stopwatch_lap(Stopwatch* sw) __attribute__((always_inline));
+static inline stopwatch_t Stopwatch_lap(Stopwatch* sw)
+{
+    stopwatch_t now = getFreeRunningCounter();
+    stopwatch_t time;
+
+    if (sw->isRunning == RSOS_bool_false)
+    {
+        return 0;
+    }
+    time = now - sw->start;
+    sw->start = now;
+    Stopwatch_record(sw, time);
+    return time;
+}
+
+/**
+ * measures the time since start or the last lap and stops the stopwatch
+ * @param sw: the stopwatch
+ * @return the measured time, 0 if the stopwatch is not running
+ */
+static inline stopwatch_t Stopwatch_stop(Stopwatch* sw) __attribute__((always_inline));
+static inline stopwatch_t Stopwatch_stop(Stopwatch* sw)
+{
+    stopwatch_t time = Stopwatch_lap(sw);
+    sw->isRunning = RSOS_bool_false;
+    return time;
+}
+
+/**
+ * @param sw: the stopwatch
+ * @return the shortest measured time, 0 if nothing was measured
+ */
+static inline stopwatch_t Stopwatch_getMin(Stopwatch* sw) __attribute__((always_inline));
+static inline stopwatch_t Stopwatch_getMin(Stopwatch* sw)
+{
+    if (sw->count == 0)
+    {
+        return 0;
+    }
+    return sw->min;
+}
+
+/**
+ * @param sw: the stopwatch
+ * @return the longest measured time
+ */
+static inline stopwatch_t Stopwatch_getMax(Stopwatch* sw) __attribute__((always_inline));
+static inline stopwatch_t Stopwatch_getMax(Stopwatch* sw)
+{
+    return sw->max;
+}
+
+/**
+ * @param sw: the stopwatch
+ * @return the number of measured times
+ */
+static inline uint16_t Stopwatch_getCount(Stopwatch* sw) __attribute__((always_inline));
+static inline uint16_t Stopwatch_getCount(Stopwatch* sw)
+{
+    return sw->count;
+}
+
+/**
+ * calculates the mean of the measured times.
+ * uses a division, do not call it in a time critical path
+ * @param sw: the stopwatch
+ * @return the mean of the measured times, 0 if nothing was measured
+ */
+__EXTERN_C
+stopwatch_t Stopwatch_getMean(Stopwatch* sw);
+
+#endif /* MAXSTOPWATCHES */
+#endif /* STOPWATCH_H_ */
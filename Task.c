@@ -9,16 +9,295 @@
 
 #include <HardwareAdaptionLayer.h>
 
+#ifdef WAITTIMER_TICKLESS
+#include "WaitTimer.h"
+#endif /* WAITTIMER_TICKLESS */
+
+#ifdef MAXDEFERREDWORK
+#include "DeferredWork.h"
+#endif /* MAXDEFERREDWORK */
+
 #define MAX_NR_OF_FOLLOWUP_TASKS 7
 
 static int8_t task_schedulerEnabled = 0;
 
+volatile uint32_t rsos_tickCount = 0;
+
+#ifdef TASK_STATISTICS
+TaskStatistics taskStatistics_mem[MAXTASKS];
+
+void Task_resetStatistics(Task* task)
+{
+	int8_t i = (task != 0) ? (task - task_mem) : 0;
+	int8_t last = (task != 0) ? i : tasks_size - 1;
+
+	for (; i<=last; i++)
+	{
+		uint16_t interruptState = enterCritical();
+		taskStatistics_mem[i].activations = 0;
+		taskStatistics_mem[i].dispatches = 0;
+		taskStatistics_mem[i].executionTime = 0;
+		taskStatistics_mem[i].maxExecutionTime = 0;
+		taskStatistics_mem[i].maxLatency = 0;
+		taskStatistics_mem[i].isWaiting = RSOS_bool_false;
+		exitCritical(interruptState);
+	}
+}
+
+/**
+ * records the latency of a task, it is measured on the first
+ * dispatch after the activation
+ * @param task: the task to execute
+ * @return the counter at the start of the execution
+ */
+static inline taskcounter_t Task_statisticsDispatched(Task* task) __attribute__((always_inline));
+static inline taskcounter_t Task_statisticsDispatched(Task* task)
+{
+	TaskStatistics* statistics = Task_getStatistics(task);
+	taskcounter_t now = getFreeRunningCounter();
+
+	if (statistics->isWaiting)
+	{
+		taskcounter_t latency = now - statistics->scheduledAt;
+		if (latency > statistics->maxLatency)
+		{
+			statistics->maxLatency = latency;
+		}
+		statistics->isWaiting = RSOS_bool_false;
+	}
+	return now;
+}
+
+/**
+ * counts the dispatch and records the execution time of a task
+ * @param task: the executed task
+ * @param started: the counter returned by Task_statisticsDispatched()
+ */
+static inline void Task_statisticsCompleted(Task* task, taskcounter_t started) __attribute__((always_inline));
+static inline void Task_statisticsCompleted(Task* task, taskcounter_t started)
+{
+	TaskStatistics* statistics = Task_getStatistics(task);
+	taskcounter_t executionTime = getFreeRunningCounter() - started;
+
+	// the task statistics stop adding to the execution time sum once the dispatch count
+	// saturates at 0xFFFF, executionTime / dispatches stays the mean of the counted dispatches
+	if (statistics->dispatches == 0xFFFF)
+	{
+		return;
+	}
+	statistics->dispatches += 1;
+	statistics->executionTime += executionTime;
+	if (executionTime > statistics->maxExecutionTime)
+	{
+		statistics->maxExecutionTime = executionTime;
+	}
+}
+#endif /* TASK_STATISTICS */
+
+#ifdef TASK_BUDGET
+volatile uint16_t task_overruns = 0;
+
+static TaskOverrunHook* task_overrunHook = 0;
+
+/**
+ * the number of the task whose budget is checked, -1 if no task is running
+ */
+static volatile int8_t task_budgetTask = -1;
+
+/**
+ * the counter at the start of the running task
+ */
+static volatile taskcounter_t task_budgetStart = 0;
+
+/**
+ * RSOS_bool_true if the overrun of the running task is reported
+ */
+static volatile RSOS_bool task_budgetReported = RSOS_bool_false;
+
+void setTaskBudget(Task* task, taskcounter_t budget)
+{
+	task->budget = budget;
+}
+
+void Task_setOverrunHook(TaskOverrunHook* hook)
+{
+	task_overrunHook = hook;
+}
+
+/**
+ * counts, traces and reports an overrun
+ * @param taskNr: the task that exceeded its budget
+ * @param executionTime: the execution time so far
+ * @param isRunning: RSOS_bool_true if the task is still running
+ */
+static void Task_overrun(int8_t taskNr, taskcounter_t executionTime, RSOS_bool isRunning)
+{
+	task_budgetReported = RSOS_bool_true;
+	if (task_overruns != 0xFFFF)
+	{
+		task_overruns += 1;
+	}
+	if (task_mem[taskNr].overruns != 0xFF)
+	{
+		task_mem[taskNr].overruns += 1;
+	}
+	TRACE(TRACE_TASK_OVERRUN, taskNr);
+	if (task_overrunHook != 0)
+	{
+		task_overrunHook(taskNr, executionTime, isRunning);
+	}
+}
+
+void Task_checkBudget()
+{
+	int8_t taskNr = task_budgetTask;
+	if (taskNr != -1 && !task_budgetReported && task_mem[taskNr].budget != 0)
+	{
+		taskcounter_t executionTime = getFreeRunningCounter() - task_budgetStart;
+		if (executionTime > task_mem[taskNr].budget)
+		{
+			Task_overrun(taskNr, executionTime, RSOS_bool_true);
+		}
+	}
+}
+
+/**
+ * starts the budget of a task, called before the task function
+ * @param taskNr: the task to execute
+ */
+static inline void Task_budgetBegin(int8_t taskNr) __attribute__((always_inline));
+static inline void Task_budgetBegin(int8_t taskNr)
+{
+	task_budgetTask = -1;		// not checked while the values change
+	task_budgetStart = getFreeRunningCounter();
+	task_budgetReported = RSOS_bool_false;
+	task_budgetTask = taskNr;
+}
+
+/**
+ * checks the budget of a task after the task function returned,
+ * an overrun already reported by Task_checkBudget() is not reported again
+ * @param taskNr: the executed task
+ */
+static inline void Task_budgetEnd(int8_t taskNr) __attribute__((always_inline));
+static inline void Task_budgetEnd(int8_t taskNr)
+{
+	taskcounter_t executionTime = getFreeRunningCounter() - task_budgetStart;
+	task_budgetTask = -1;
+	if (!task_budgetReported && task_mem[taskNr].budget != 0 && executionTime > task_mem[taskNr].budget)
+	{
+		Task_overrun(taskNr, executionTime, RSOS_bool_false);
+	}
+}
+#endif /* TASK_BUDGET */
+
+#ifdef SCHEDULER_READYBITMAP
+volatile uint16_t task_readyPriorities = 0;
+volatile int8_t task_readyHead[priorityMask + 1] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+volatile int8_t task_readyTail[priorityMask + 1] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+
+/**
+ * position of the highest set bit in a nibble
+ */
+static const uint8_t task_highestBit[16] = {0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3};
+
+/**
+ * returns the highest priority in the ready bitmap
+ * @param ready: the bitmap, must not be 0
+ * @return the number of the highest set bit
+ */
+static inline uint8_t Task_highestPriority(uint16_t ready) __attribute__((always_inline));
+static inline uint8_t Task_highestPriority(uint16_t ready)
+{
+    if (ready & 0xFF00)
+    {
+        if (ready & 0xF000)
+        {
+            return 12 + task_highestBit[ready >> 12];
+        }
+        return 8 + task_highestBit[(ready >> 8) & 0x0F];
+    }
+    if (ready & 0x00F0)
+    {
+        return 4 + task_highestBit[(ready >> 4) & 0x0F];
+    }
+    return task_highestBit[ready & 0x0F];
+}
+
+/**
+ * removes a task from the ready list of its priority.
+ * the task is usually the first in the list, so this is fast.
+ * only to be called with interrupts disabled
+ * @param task: the task to remove
+ */
+static inline void Task_readyListRemove(Task* task) __attribute__((always_inline));
+static inline void Task_readyListRemove(Task* task)
+{
+    uint8_t prio = task->status & priorityMask;
+    int8_t taskNr = task - task_mem;
+    int8_t previous = -1;
+    int8_t i = task_readyHead[prio];
+
+    while (i != -1 && i != taskNr)
+    {
+        previous = i;
+        i = task_mem[i].nextReady;
+    }
+    if (i == -1)
+    {
+        return;     //not in the list
+    }
+
+    if (previous == -1)
+    {
+        task_readyHead[prio] = task->nextReady;
+    }
+    else
+    {
+        task_mem[previous].nextReady = task->nextReady;
+    }
+    if (task_readyTail[prio] == taskNr)
+    {
+        task_readyTail[prio] = previous;
+    }
+    if (task_readyHead[prio] == -1)
+    {
+        task_readyPriorities &= ~(1 << prio);
+    }
+    task->nextReady = -1;
+}
+#endif /* SCHEDULER_READYBITMAP */
+
 Task* addTask(unsigned char priority, TaskFunction* taskfunction)
 {
 	task_mem[tasks_size].status = (priority & priorityMask);
 	task_mem[tasks_size].task = taskfunction;
 	task_mem[tasks_size].currentCycle = 0;
 	task_mem[tasks_size].currentDelay = 0;
+#ifdef SCHEDULER_READYBITMAP
+	task_mem[tasks_size].nextReady = -1;
+#endif /* SCHEDULER_READYBITMAP */
+#ifdef TASK_ARGUMENT
+	task_mem[tasks_size].argument = 0;
+#endif /* TASK_ARGUMENT */
+#ifdef TASK_RESUMABLE
+	task_mem[tasks_size].resumePoint = 0;
+#endif /* TASK_RESUMABLE */
+#ifdef SCHEDULER_EDF
+	task_mem[tasks_size].relativeDeadline = Task_noDeadline;
+	task_mem[tasks_size].deadline = 0;
+#endif /* SCHEDULER_EDF */
+#ifdef TASK_JOIN
+	task_mem[tasks_size].joinCount = 0;
+	task_mem[tasks_size].joinPending = 0;
+#endif /* TASK_JOIN */
+#ifdef TASK_BUDGET
+	task_mem[tasks_size].budget = 0;
+	task_mem[tasks_size].overruns = 0;
+#endif /* TASK_BUDGET */
+#ifdef SCHEDULER_AGING
+	task_mem[tasks_size].age = 0;
+#endif /* SCHEDULER_AGING */
 
 	tasks_size += 1;
 	return &task_mem[tasks_size-1];
@@ -49,6 +328,42 @@ void addFollowUpTask(Task* task, Task* *followUpArray, Task* followUpTask)
 	}
 }
 
+#ifdef TASK_JOIN
+void addJoinTask(Task* task, Task* *followUpArray, Task* joinTask)
+{
+	unsigned char numberOfFollowUps = (task->status & followUpNumberMask) >> 12;
+
+	addFollowUpTask(task, followUpArray, joinTask);
+
+	if (((task->status & followUpNumberMask) >> 12) != numberOfFollowUps)	//added
+	{
+		joinTask->joinCount += 1;
+		joinTask->joinPending += 1;
+	}
+}
+
+/**
+ * called for each follow up task when a task is completed.
+ * a join task is scheduled when its last predecessor is completed,
+ * then it waits for all predecessors again
+ * @param followUpTask: the follow up task
+ */
+static inline void Task_predecessorCompleted(Task* followUpTask) __attribute__((always_inline));
+static inline void Task_predecessorCompleted(Task* followUpTask)
+{
+	if (followUpTask->joinCount != 0)
+	{
+		followUpTask->joinPending -= 1;
+		if (followUpTask->joinPending != 0)
+		{
+			return;
+		}
+		followUpTask->joinPending = followUpTask->joinCount;
+	}
+	scheduleTask(followUpTask);
+}
+#endif /* TASK_JOIN */
+
 void setTaskCyclic(Task* task, char cycles)
 {
 	task->status |= ((cycles-1) << 8) & cycleNumberMask;
@@ -61,6 +376,13 @@ void setTaskDelay(Task* task, char delay)
 	task->currentDelay = delay;
 }
 
+#ifdef SCHEDULER_EDF
+void setTaskDeadline(Task* task, uint16_t deadline)
+{
+	task->relativeDeadline = (deadline < Task_noDeadline) ? deadline : Task_noDeadline;
+}
+#endif /* SCHEDULER_EDF */
+
 void enableScheduler()
 {
 	task_schedulerEnabled = 1;
@@ -86,18 +408,33 @@ static inline void resetCycles(Task* task)
 static inline void unscheduleTask(Task* task) __attribute__((always_inline));
 static inline void unscheduleTask(Task* task)
 {
+#ifdef SCHEDULER_READYBITMAP
+    uint16_t interruptState = enterCritical();
     if (task->status & Task_isActive) {
         task->status &= ~Task_isActive;
         numberOfRunningTasks -= 1;
         currentPriority = 0;
+        Task_readyListRemove(task);
     }
+    exitCritical(interruptState);
+#else
+    if (task->status & Task_isActive) {
+        task->status &= ~Task_isActive;
+        numberOfRunningTasks -= 1;
+        currentPriority = 0;
+    }
+#endif /* SCHEDULER_READYBITMAP */
 
     if (task->followUpTask != 0)
     {
-        signed char i = ((task->status & followUpNumberMask) >> 12) - 1;
+        signed char i = ((task->status & followUpNumberMask) >> 12);
         for (; i>0; i--)
         {
+#ifdef TASK_JOIN
+            Task_predecessorCompleted(task->followUpTask[i-1]);
+#else
             scheduleTask(task->followUpTask[i-1]);
+#endif /* TASK_JOIN */
         }
     }
 
@@ -109,15 +446,153 @@ static inline void unscheduleTask(Task* task)
 #endif /* NEWSCHEDULER */
 }
 
+#ifdef SCHEDULER_ROUNDROBIN
+#ifdef SCHEDULER_READYBITMAP
+/**
+ * moves a task that stays active after its execution to the end of its ready list,
+ * the next task of the same priority is executed first
+ * @param task: the executed task
+ */
+static inline void Task_roundRobin(Task* task) __attribute__((always_inline));
+static inline void Task_roundRobin(Task* task)
+{
+    uint16_t interruptState = enterCritical();
+    uint8_t prio = task->status & priorityMask;
+    if ((task->status & Task_isActive) && task_readyTail[prio] != (task - task_mem))
+    {
+        Task_readyListRemove(task);
+        Task_readyListAppend(task);
+    }
+    exitCritical(interruptState);
+}
+#else
+/**
+ * the task executed last per priority, -1 if none
+ */
+static int8_t task_lastDispatched[priorityMask + 1] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+
+/**
+ * stores the executed task, the next task of the same priority is executed first
+ * @param task: the executed task
+ */
+static inline void Task_roundRobin(Task* task) __attribute__((always_inline));
+static inline void Task_roundRobin(Task* task)
+{
+	task_lastDispatched[task->status & priorityMask] = task - task_mem;
+}
+#endif /* SCHEDULER_READYBITMAP */
+#endif /* SCHEDULER_ROUNDROBIN */
+
 /**
  * returns the task that is active and has the highest priority
+ * (with SCHEDULER_ROUNDROBIN of these the first after the task executed last)
  * @return a number in the task_mem array or -1 if no task is active
  */
 static inline int8_t getNextTaskNumber() __attribute__((always_inline));
+#ifdef SCHEDULER_READYBITMAP
+static inline int8_t getNextTaskNumber()
+{
+    uint16_t ready = task_readyPriorities;
+    if (ready)
+    {
+        uint8_t prio = Task_highestPriority(ready);
+        int8_t i = task_readyHead[prio];
+#ifdef STRADEGY_NOBREAK_ONDELAY
+        // as the scan: if all tasks of the highest priority are delayed,
+        // the lower priorities wait as well (-1 is returned)
+        while (i != -1 && (task_mem[i].currentDelay & Task_isDelayed))
+        {
+            i = task_mem[i].nextReady;
+        }
+#endif /* STRADEGY_NOBREAK_ONDELAY */
+        currentPriority = prio;
+        return i;
+    }
+    return -1;
+}
+#elif defined SCHEDULER_EDF
+static inline int8_t getNextTaskNumber()
+{
+	int8_t i;
+	int8_t earliestTask = -1;
+	numberOfRunningTasks = 0;
+	for (i=tasks_size; i>0; i-=1)
+	{
+		if (task_mem[i-1].status & Task_isActive)
+		{
+		    numberOfRunningTasks += 1;
+
+#ifdef STRADEGY_NOBREAK_ONDELAY
+			if (task_mem[i-1].currentDelay & Task_isDelayed)
+			{
+				continue;
+			}
+#endif /* STRADEGY_NOBREAK_ONDELAY */
+			// the deadlines wrap around, compare the distance
+			if (earliestTask == -1 ||
+				(int16_t)(task_mem[i-1].deadline - task_mem[earliestTask].deadline) <= 0)
+			{
+				earliestTask = i-1;
+			}
+		}
+	}
+	if (earliestTask != -1)
+	{
+		currentPriority = task_mem[earliestTask].status & priorityMask;
+	}
+	return earliestTask;
+}
+#else
+#ifdef SCHEDULER_AGING
+/**
+ * the age at which the priority is raised to one above the highest priority
+ */
+#define Task_maxAge ((priorityMask + 1) * SCHEDULER_AGING)
+
+/**
+ * counts a call of getNextTaskNumber() the task waits in (not while it is delayed)
+ * @param task: an active task
+ * @return the priority of the task raised by its age
+ */
+static inline int8_t Task_agedPriority(Task* task) __attribute__((always_inline));
+static inline int8_t Task_agedPriority(Task* task)
+{
+#ifdef STRADEGY_NOBREAK_ONDELAY
+	if (! (task->currentDelay & Task_isDelayed) )
+#endif /* STRADEGY_NOBREAK_ONDELAY */
+	{
+		if (task->age < Task_maxAge)
+		{
+			task->age += 1;
+		}
+	}
+	return (task->status & priorityMask) + task->age / SCHEDULER_AGING;
+}
+
+/**
+ * the task is executed, its priority falls back. if it ran above its priority,
+ * the currentPriority is determined again by the next call of getNextTaskNumber()
+ * @param task: the task to execute
+ */
+static inline void Task_resetAge(Task* task) __attribute__((always_inline));
+static inline void Task_resetAge(Task* task)
+{
+	if (task->age >= SCHEDULER_AGING)
+	{
+		currentPriority = 0;
+	}
+	task->age = 0;
+}
+#endif /* SCHEDULER_AGING */
+
 static inline int8_t getNextTaskNumber()
 {
 	int8_t i;
 	int8_t maxPrioTask = -1;
+#ifdef SCHEDULER_ROUNDROBIN
+	int8_t maxPrio = -1;
+	int8_t nextTask = -1;		// the first task after the one executed last
+#endif /* SCHEDULER_ROUNDROBIN */
 	numberOfRunningTasks = 0;
 	for (i=tasks_size; i>0; i-=1)
 	{
@@ -125,13 +600,29 @@ static inline int8_t getNextTaskNumber()
 		{
 		    numberOfRunningTasks += 1;
 
+#ifdef SCHEDULER_AGING
+			int8_t prio = Task_agedPriority(&task_mem[i-1]);
+#else
 			int8_t prio = task_mem[i-1].status & priorityMask;
+#endif /* SCHEDULER_AGING */
 			if ( (prio) >= currentPriority)
 			{
 #ifdef STRADEGY_NOBREAK_ONDELAY
 				if (! (task_mem[i-1].currentDelay & Task_isDelayed) )
 #endif /* STRADEGY_NOBREAK_ONDELAY */
 				{
+#ifdef SCHEDULER_ROUNDROBIN
+					// the priority never falls during the scan, a new one starts a new turn
+					if (prio != maxPrio)
+					{
+						maxPrio = prio;
+						nextTask = -1;
+					}
+					if (i-1 > task_lastDispatched[task_mem[i-1].status & priorityMask])
+					{
+						nextTask = i-1;
+					}
+#endif /* SCHEDULER_ROUNDROBIN */
 					maxPrioTask = i-1;
 				}
 				currentPriority = prio;
@@ -139,70 +630,211 @@ static inline int8_t getNextTaskNumber()
 
 		}
 	}
+#ifdef SCHEDULER_ROUNDROBIN
+	if (nextTask != -1)
+	{
+		return nextTask;
+	}
+#endif /* SCHEDULER_ROUNDROBIN */
 	return maxPrioTask;
 }
+#endif /* SCHEDULER_READYBITMAP */
 
 #ifdef NEWSCHEDULER
+/**
+ * calls the work posted to DeferredWork, then chooses the next task,
+ * so work posted by an interrupt while a task ran is done before the next task
+ * @return the number of the next task, -1 if none
+ */
+static inline int8_t Task_drainAndGetNext() __attribute__((always_inline));
+static inline int8_t Task_drainAndGetNext()
+{
+#ifdef MAXDEFERREDWORK
+	DeferredWork_drain();
+#endif /* MAXDEFERREDWORK */
+	return getNextTaskNumber();
+}
+
+#ifdef SCHEDULER_PREEMPTIVE
+/**
+ * 1 while a task function is executed, only then schedulerPreempt() interrupts the scheduler
+ */
+static volatile uint8_t task_preemptible = 0;
+
+/**
+ * @return RSOS_bool_true if the task is to be executed before the other task:
+ *         it has an earlier deadline (SCHEDULER_EDF) or a higher priority
+ */
+static inline RSOS_bool Task_precedes(int8_t taskNr, int8_t otherTaskNr) __attribute__((always_inline));
+static inline RSOS_bool Task_precedes(int8_t taskNr, int8_t otherTaskNr)
+{
+#ifdef SCHEDULER_EDF
+	return (int16_t)(task_mem[taskNr].deadline - task_mem[otherTaskNr].deadline) < 0;
+#else
+	return (task_mem[taskNr].status & priorityMask) > (task_mem[otherTaskNr].status & priorityMask);
+#endif /* SCHEDULER_EDF */
+}
+#endif /* SCHEDULER_PREEMPTIVE */
+
+/**
+ * executes a task returned by getNextTaskNumber(): counts down the delay of the task
+ * or executes it and unschedules it when it is completed
+ * @param task: the task
+ * @return RSOS_bool_false if the task is delayed and the scheduler must exit
+ */
+static RSOS_bool Task_dispatch(Task* task)
+{
+	if (task->currentDelay != 0x00)
+	{
+		task->currentDelay -= 1;
+#ifdef STRADEGY_NOBREAK_ONDELAY
+		task->currentDelay |= Task_isDelayed;
+#else
+		return RSOS_bool_false;
+#endif /* STRADEGY_NOBREAK_ONDELAY */
+	}
+	else 					//if the delay is zero
+	{
+		if (task->status & hasWaitTime)
+		{
+			resetDelay(task);
+		}
+
+#ifdef SCHEDULER_AGING
+		Task_resetAge(task);
+#endif /* SCHEDULER_AGING */
+#ifdef TASK_STATISTICS
+		taskcounter_t started = Task_statisticsDispatched(task);
+#endif /* TASK_STATISTICS */
+#ifdef TASK_BUDGET
+		Task_budgetBegin(task - task_mem);
+#endif /* TASK_BUDGET */
+#ifdef SCHEDULER_PREEMPTIVE
+		task_preemptible = 1;
+#endif /* SCHEDULER_PREEMPTIVE */
+		TRACE(TRACE_TASK_BEGIN, task - task_mem);
+		task->task();
+		TRACE(TRACE_TASK_END, task - task_mem);
+#ifdef SCHEDULER_PREEMPTIVE
+		task_preemptible = 0;
+#endif /* SCHEDULER_PREEMPTIVE */
+#ifdef TASK_BUDGET
+		Task_budgetEnd(task - task_mem);
+#endif /* TASK_BUDGET */
+#ifdef TASK_STATISTICS
+		Task_statisticsCompleted(task, started);
+#endif /* TASK_STATISTICS */
+
+#ifdef TASK_RESUMABLE
+		if (task->resumePoint != 0)
+		{
+			// the task yielded, it stays active and resumes on its next run
+		}
+		else
+#endif /* TASK_RESUMABLE */
+		if (task->status & isCycleTask)
+		{
+			if (task->currentCycle == 0x00)
+			{
+				resetCycles(task);
+				unscheduleTask(task);
+			}
+			else
+			{
+				task->currentCycle -= 1;
+			}
+		}
+		else
+		{
+			unscheduleTask(task);
+		}
+#ifdef SCHEDULER_ROUNDROBIN
+		Task_roundRobin(task);
+#endif /* SCHEDULER_ROUNDROBIN */
+	}
+	return RSOS_bool_true;
+}
+
 void scheduler()
 {
 	while (numberOfRunningTasks || task_schedulerEnabled)
 	{
 		schedulerEntered();
 #ifdef STRADEGY_NOWAIT
-		for (currentRunningTask = getNextTaskNumber();
+		for (currentRunningTask = Task_drainAndGetNext();
 			 currentRunningTask != -1;
-			 currentRunningTask = getNextTaskNumber())
+			 currentRunningTask = Task_drainAndGetNext())
 #endif // STRADEGY_NOWAIT //
 		{
 #ifndef STRADEGY_NOWAIT
-			currentRunningTask = getNextTaskNumber();
+			currentRunningTask = Task_drainAndGetNext();
 #endif // STRADEGY_NOWAIT //
 			if (currentRunningTask != -1)
 			{
-				Task* task = &task_mem[currentRunningTask];
-
-				if (task->currentDelay != 0x00)
+				if (!Task_dispatch(&task_mem[currentRunningTask]))
 				{
-					task->currentDelay -= 1;
-#ifdef STRADEGY_NOBREAK_ONDELAY
-					task->currentDelay |= Task_isDelayed;
-#else
 					break;		//exit scheduler
-#endif /* STRADEGY_NOBREAK_ONDELAY */
-				}
-				else 					//if the delay is zero
-				{
-					if (task->status & hasWaitTime)
-					{
-						resetDelay(task);
-					}
-
-					task->task();
-
-					if (task->status & isCycleTask)
-					{
-						if (task->currentCycle == 0x00)
-						{
-							resetCycles(task);
-							unscheduleTask(task);
-						}
-						else
-						{
-							task->currentCycle -= 1;
-						}
-					}
-					else
-					{
-						unscheduleTask(task);
-					}
 				}
 			}
 		}
 
 		schedulerExited();
+#ifdef MAXDEFERREDWORK
+		if (DeferredWork_isPending())
+		{
+			continue;		// work posted after the last drain, do not sleep
+		}
+#endif /* MAXDEFERREDWORK */
+#ifdef WAITTIMER_TICKLESS
+		Timer_setNextWakeup();
+#endif /* WAITTIMER_TICKLESS */
+		TRACE(TRACE_IDLE_BEGIN, 0);
 		schedulerWait();
+		TRACE(TRACE_IDLE_END, 0);
 	}
 }
+
+#ifdef SCHEDULER_PREEMPTIVE
+void schedulerPreempt()
+{
+	if (!task_preemptible)
+	{
+		return;
+	}
+
+	int8_t preemptedTask = currentRunningTask;
+	uint8_t preemptedPriority = currentPriority;
+#ifdef TASK_BUDGET
+	// the execution time of the preempted task includes the preempting tasks
+	taskcounter_t preemptedBudgetStart = task_budgetStart;
+	RSOS_bool preemptedBudgetReported = task_budgetReported;
+#endif /* TASK_BUDGET */
+
+	task_preemptible = 0;
+	preemptSchedulerEntered();
+
+	for (currentRunningTask = getNextTaskNumber();
+		 currentRunningTask != -1 && Task_precedes(currentRunningTask, preemptedTask);
+		 currentRunningTask = getNextTaskNumber())
+	{
+		if (!Task_dispatch(&task_mem[currentRunningTask]))
+		{
+			break;
+		}
+	}
+
+	preemptSchedulerExited();
+	currentRunningTask = preemptedTask;
+	currentPriority = preemptedPriority;
+#ifdef TASK_BUDGET
+	task_budgetTask = -1;
+	task_budgetStart = preemptedBudgetStart;
+	task_budgetReported = preemptedBudgetReported;
+	task_budgetTask = preemptedTask;
+#endif /* TASK_BUDGET */
+	task_preemptible = 1;
+}
+#endif /* SCHEDULER_PREEMPTIVE */
 // old scheduler function
 #else
 void scheduler()
@@ -212,6 +844,9 @@ void scheduler()
 		signed char i;
 		Task* task;
 		schedulerEntered();
+#ifdef MAXDEFERREDWORK
+		DeferredWork_drain();
+#endif /* MAXDEFERREDWORK */
 		for (i=tasks_size-1; i>=0; i--)
 		{
 			task = &task_mem[i];
@@ -223,8 +858,29 @@ void scheduler()
 				{
 					if ( (task->status & priorityMask) >= currentPriority)//if the currentPriority is even / higher than
 					{
+#ifdef TASK_STATISTICS
+						taskcounter_t started = Task_statisticsDispatched(task);
+#endif /* TASK_STATISTICS */
+#ifdef TASK_BUDGET
+						Task_budgetBegin(i);
+#endif /* TASK_BUDGET */
+						TRACE(TRACE_TASK_BEGIN, i);
 						task->task();
+						TRACE(TRACE_TASK_END, i);
+#ifdef TASK_BUDGET
+						Task_budgetEnd(i);
+#endif /* TASK_BUDGET */
+#ifdef TASK_STATISTICS
+						Task_statisticsCompleted(task, started);
+#endif /* TASK_STATISTICS */
 
+#ifdef TASK_RESUMABLE
+						if (task->resumePoint != 0)
+						{
+							// the task yielded, it stays active and resumes on its next run
+						}
+						else
+#endif /* TASK_RESUMABLE */
 						if (task->status & isCycleTask)
 						{
 							if (task->currentCycle == 0x00)
@@ -257,7 +913,18 @@ void scheduler()
 			}
 		}
 		schedulerExited();
+#ifdef MAXDEFERREDWORK
+		if (DeferredWork_isPending())
+		{
+			continue;		// work posted after the last drain, do not sleep
+		}
+#endif /* MAXDEFERREDWORK */
+#ifdef WAITTIMER_TICKLESS
+		Timer_setNextWakeup();
+#endif /* WAITTIMER_TICKLESS */
+		TRACE(TRACE_IDLE_BEGIN, 0);
 		schedulerWait();
+		TRACE(TRACE_IDLE_END, 0);
 //		__bis_SR_register(LPM0_bits + GIE);       // Enter LPM0 w/ interrupt
 //		__bis_SR_register(LPM3_bits + GIE);       // Enter LPM3 w/ interrupt
 	}
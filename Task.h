@@ -14,6 +14,29 @@
  *      added function getTaskNumber
  * 2017 03 05
  *      moved function scheduleTask(), getTaskNumber(), to header for inlining
+ * 2026 10 18
+ *      added compile flag SCHEDULER_READYBITMAP: ready bitmap and per priority ready lists
+ *      for the NEWSCHEDULER, the next task is found without scanning task_mem
+ *      added tick counter rsos_tickCount and function RSOS_now()
+ *      scheduler() calls the work posted to DeferredWork (if MAXDEFERREDWORK is defined)
+ *      before it chooses the next task, it does not go to sleep while work is posted
+ *      added compile flag TASK_ARGUMENT: a context pointer per task, set by scheduleTaskWithArg()
+ *      added compile flag TASK_RESUMABLE: task functions can yield and resume (TASK_BEGIN, TASK_YIELD)
+ *      added compile flag SCHEDULER_PREEMPTIVE: schedulerPreempt() runs tasks of higher priority
+ *      from an interrupt routine, the running task is interrupted
+ *      added compile flag SCHEDULER_EDF: earliest deadline first, function setTaskDeadline()
+ *      fixed unscheduleTask(): the last follow up task was not scheduled
+ *      added compile flag TASK_JOIN: a task is scheduled when all its predecessors are completed,
+ *      function addJoinTask()
+ *      added compile flag TASK_STATISTICS: activations, dispatches, execution time and
+ *      latency per task, functions Task_getStatistics(), Task_resetStatistics()
+ *      scheduleTask() and the scheduler record trace events (if MAXTRACEEVENTS is defined, @see Trace.h)
+ *      added compile flag TASK_BUDGET: execution time budget per task and overrun detection,
+ *      functions setTaskBudget(), Task_setOverrunHook(), Task_checkBudget()
+ *      added compile flag SCHEDULER_AGING: the priority of a waiting task rises with
+ *      the calls of getNextTaskNumber() it is skipped in
+ *      added compile flag SCHEDULER_ROUNDROBIN: active tasks of the same priority
+ *      are executed in turn instead of the lowest task number first
  */
 
 #ifndef TASK_H_
@@ -26,11 +49,173 @@
 #define NEWSCHEDULER
 #define STRADEGY_NOBREAK_ONDELAY
 
+/**
+ * optional compile flags, define here or in RSOSDefines.h
+ *
+ * SCHEDULER_READYBITMAP (only with NEWSCHEDULER):
+ *      active tasks are kept in one ready list per priority, a bitmap marks
+ *      the priorities with active tasks. the next task is found in constant
+ *      time instead of scanning all tasks. As in the scan, a delayed task
+ *      (STRADEGY_NOBREAK_ONDELAY) of the highest priority blocks the lower priorities.
+ *      Needs 1 Byte more per task and
+ *      the hooks enterCritical() / exitCritical() in the HardwareAdaptionLayer
+ */
+//#define SCHEDULER_READYBITMAP
+
+/**
+ * TASK_ARGUMENT:
+ *      every task holds a context pointer (argument), set by scheduleTaskWithArg()
+ *      and read by the task function with Task_getArgument(), for example the object
+ *      that triggered the task. Needs 1 pointer more per task and the hooks
+ *      enterCritical() / exitCritical() in the HardwareAdaptionLayer
+ */
+//#define TASK_ARGUMENT
+
+/**
+ * TASK_RESUMABLE:
+ *      a task function can yield in the middle of its work and resume at the same
+ *      point on its next run (stackless, @see TASK_BEGIN()). Needs 2 Bytes more per task
+ */
+//#define TASK_RESUMABLE
+
+/**
+ * SCHEDULER_PREEMPTIVE (only with NEWSCHEDULER):
+ *      an interrupt routine that scheduled a task calls schedulerPreempt() at its end,
+ *      tasks with a higher priority than the running task are executed at once on
+ *      the stack of the interrupt routine. Needs the hooks
+ *      preemptSchedulerEntered() / preemptSchedulerExited() in the HardwareAdaptionLayer
+ */
+//#define SCHEDULER_PREEMPTIVE
+
+/**
+ * SCHEDULER_EDF (only with NEWSCHEDULER, not with SCHEDULER_READYBITMAP):
+ *      earliest deadline first. every task has a relative deadline in timer ticks
+ *      (setTaskDeadline()), when the task is scheduled its deadline is set to
+ *      rsos_tickCount + relative deadline. the scheduler executes the active task
+ *      with the earliest deadline, the priority is not used.
+ *      the deadlines are 16 Bit and compared by their distance, (int16_t)(a - b) < 0,
+ *      so the order is right while the deadlines of the active tasks are less than
+ *      0x8000 ticks apart. a task still waiting 0x8000 ticks after its deadline
+ *      (an overload) compares as later than the tasks scheduled then and may be starved.
+ *      Needs 4 Bytes more per task
+ */
+//#define SCHEDULER_EDF
+
+/**
+ * TASK_JOIN:
+ *      a task can wait for several predecessor tasks (addJoinTask()), it is scheduled
+ *      when the last of them is completed. Needs 2 Bytes more per task
+ */
+//#define TASK_JOIN
+
+/**
+ * TASK_STATISTICS:
+ *      the scheduler records per task the number of activations and dispatches,
+ *      the sum and maximum of the execution time and the maximum latency from
+ *      scheduleTask() to the dispatch (@see TaskStatistics). The times are read from
+ *      the free running counter of the HardwareAdaptionLayer, getFreeRunningCounter()
+ *      (16 Bit, 32 Bit with STOPWATCH_32BIT, as for the Stopwatch).
+ *      Needs 16 Bytes per task (26 Bytes with STOPWATCH_32BIT)
+ */
+//#define TASK_STATISTICS
+
+/**
+ * TASK_BUDGET:
+ *      every task can have an execution time budget (setTaskBudget()) in counts of
+ *      getFreeRunningCounter() (as TASK_STATISTICS). an execution longer than the
+ *      budget is an overrun: it is counted, traced and passed to a hook of the application.
+ *      Task_checkBudget(), called by Timer_ISR(), detects the overrun while the task
+ *      is still running. Needs 3 Bytes more per task (5 Bytes with STOPWATCH_32BIT)
+ */
+//#define TASK_BUDGET
+
+/**
+ * SCHEDULER_AGING (only with NEWSCHEDULER, not with SCHEDULER_READYBITMAP,
+ * SCHEDULER_EDF or SCHEDULER_PREEMPTIVE):
+ *      define as the number of calls of getNextTaskNumber() (1 to 15) a waiting task
+ *      is skipped in until its priority rises by one. getNextTaskNumber() is called
+ *      once per executed task and once more before the scheduler goes to sleep,
+ *      so the age counts the executions of other tasks, not the wakeups of the scheduler.
+ *      the priority rises up to one above the highest priority and falls back when
+ *      the task is executed, so a task of priority p waits at most
+ *      (16 - p) * SCHEDULER_AGING calls plus the executions of other aged tasks.
+ *      not with SCHEDULER_PREEMPTIVE: schedulerPreempt() compares the fixed priorities
+ *      and would age the waiting tasks with every preemption.
+ *      Needs 1 Byte more per task
+ */
+//#define SCHEDULER_AGING 4
+
+/**
+ * SCHEDULER_ROUNDROBIN (only with NEWSCHEDULER, not with SCHEDULER_EDF):
+ *      of the active tasks with the same priority, the task after the one executed
+ *      last is executed next, instead of always the lowest task number.
+ *      scanning: the last executed task per priority is stored (16 Bytes).
+ *      SCHEDULER_READYBITMAP: a task that stays active after its execution
+ *      is moved to the end of its ready list
+ */
+//#define SCHEDULER_ROUNDROBIN
+
 #include <RSOSDefines.h>
 
 #include <stdint.h>
 
 #include "RSOS_BasicInclude.h"
+#include "Trace.h"
+
+#ifdef SCHEDULER_READYBITMAP
+#ifndef NEWSCHEDULER
+#error "SCHEDULER_READYBITMAP needs NEWSCHEDULER"
+#endif /* NEWSCHEDULER */
+#endif /* SCHEDULER_READYBITMAP */
+
+#ifdef SCHEDULER_PREEMPTIVE
+#ifndef NEWSCHEDULER
+#error "SCHEDULER_PREEMPTIVE needs NEWSCHEDULER"
+#endif /* NEWSCHEDULER */
+#endif /* SCHEDULER_PREEMPTIVE */
+
+#ifdef SCHEDULER_EDF
+#ifndef NEWSCHEDULER
+#error "SCHEDULER_EDF needs NEWSCHEDULER"
+#endif /* NEWSCHEDULER */
+#ifdef SCHEDULER_READYBITMAP
+#error "SCHEDULER_EDF can not be used with SCHEDULER_READYBITMAP"
+#endif /* SCHEDULER_READYBITMAP */
+#endif /* SCHEDULER_EDF */
+
+#ifdef SCHEDULER_AGING
+#ifndef NEWSCHEDULER
+#error "SCHEDULER_AGING needs NEWSCHEDULER"
+#endif /* NEWSCHEDULER */
+#if defined SCHEDULER_READYBITMAP || defined SCHEDULER_EDF
+#error "SCHEDULER_AGING can not be used with SCHEDULER_READYBITMAP or SCHEDULER_EDF"
+#endif /* SCHEDULER_READYBITMAP || SCHEDULER_EDF */
+#ifdef SCHEDULER_PREEMPTIVE
+#error "SCHEDULER_AGING can not be used with SCHEDULER_PREEMPTIVE"
+#endif /* SCHEDULER_PREEMPTIVE */
+#if SCHEDULER_AGING < 1 || SCHEDULER_AGING > 15
+#error "SCHEDULER_AGING must be 1 to 15"
+#endif
+#endif /* SCHEDULER_AGING */
+
+#ifdef SCHEDULER_ROUNDROBIN
+#ifndef NEWSCHEDULER
+#error "SCHEDULER_ROUNDROBIN needs NEWSCHEDULER"
+#endif /* NEWSCHEDULER */
+#ifdef SCHEDULER_EDF
+#error "SCHEDULER_ROUNDROBIN can not be used with SCHEDULER_EDF"
+#endif /* SCHEDULER_EDF */
+#endif /* SCHEDULER_ROUNDROBIN */
+
+#if defined SCHEDULER_READYBITMAP || defined TASK_ARGUMENT || defined TASK_STATISTICS || defined TASK_BUDGET
+/*
+ * the ready lists and the task argument are changed from interrupts (scheduleTask())
+ * and from the scheduler. the statistics and the budget read the free running counter.
+ * uint16_t enterCritical(): disables interrupts, returns the former interrupt state
+ * void exitCritical(uint16_t): restores the interrupt state
+ */
+#include <HardwareAdaptionLayer.h>
+#endif /* SCHEDULER_READYBITMAP || TASK_ARGUMENT || TASK_STATISTICS || TASK_BUDGET */
 
 /**
  * bit identifier: active
@@ -73,10 +258,37 @@
  */
 #define priorityMask 0x000F
 
+#ifdef SCHEDULER_EDF
+/**
+ * relative deadline of a task without deadline (SCHEDULER_EDF)
+ * the longest deadline possible, such tasks are executed after the tasks with a deadline.
+ * such a task is not starved unless other tasks keep the scheduler busy until 0x8000 ticks
+ * after its deadline, from then on its deadline compares as later than the deadlines
+ * of newly scheduled tasks (see SCHEDULER_EDF)
+ */
+#define Task_noDeadline 0x7FFF
+#endif /* SCHEDULER_EDF */
+
+#if defined TASK_STATISTICS || defined TASK_BUDGET
+#ifdef STOPWATCH_32BIT
+/**
+ * type of the free running counter and the measured times
+ */
+typedef uint32_t taskcounter_t;
+
+/**
+ * type of the sum of the execution times
+ */
+typedef uint64_t taskcountersum_t;
+#else
+typedef uint16_t taskcounter_t;
+typedef uint32_t taskcountersum_t;
+#endif /* STOPWATCH_32BIT */
+#endif /* TASK_STATISTICS || TASK_BUDGET */
+
 /**
  * type definition of the function executed when task is scheduled
- * todo: void* (TaskFunction) (void*) to pass arguments and return values
- * specify those pointers in the linked task structure
+ * with TASK_ARGUMENT, the function reads its argument with Task_getArgument()
  */
 typedef void (TaskFunction) (void);
 
@@ -118,10 +330,27 @@ struct Task_t;
  * 				  (the task can't be executed as long as this bit is set)
  * 	currentCycle: cycle counter when executed
  * 	followUpTask: more task structures
+ * 	nextReady: (SCHEDULER_READYBITMAP only) the next task number in the
+ * 	           ready list of the same priority, -1 at the end of the list
+ * 	argument: (TASK_ARGUMENT only) the context pointer of the task, 0 if unknown
+ * 	resumePoint: (TASK_RESUMABLE only) the point the task function resumes at, 0 to start at the beginning
+ * 	relativeDeadline: (SCHEDULER_EDF only) the deadline in ticks after the task is scheduled
+ * 	deadline: (SCHEDULER_EDF only) the absolute deadline (lower 16 Bit of rsos_tickCount)
+ * 	joinCount: (TASK_JOIN only) the number of predecessors, 0 if the task is no join task
+ * 	joinPending: (TASK_JOIN only) the number of predecessors not completed yet
+ * 	budget: (TASK_BUDGET only) the longest execution time allowed, 0 for no budget
+ * 	overruns: (TASK_BUDGET only) the number of executions longer than the budget (stops at 255)
+ * 	age: (SCHEDULER_AGING only) the calls of getNextTaskNumber() the task is skipped in
+ * 	     since it was executed,
+ * 	     its priority is raised by age / SCHEDULER_AGING
  *
  *
  * MEMORY:
  *  This structure takes up 8 Bytes
+ *  (9 Bytes with SCHEDULER_READYBITMAP, 1 pointer more with TASK_ARGUMENT,
+ *  2 Bytes more with TASK_RESUMABLE, 4 Bytes more with SCHEDULER_EDF,
+ *  2 Bytes more with TASK_JOIN, 3 Bytes more with TASK_BUDGET,
+ *  1 Byte more with SCHEDULER_AGING)
  */
 typedef struct Task_t {
 	TaskFunction* task;
@@ -129,17 +358,167 @@ typedef struct Task_t {
 	volatile uint8_t currentDelay;
 	volatile uint8_t currentCycle;
 	struct Task_t* *followUpTask;
+#ifdef SCHEDULER_READYBITMAP
+	volatile int8_t nextReady;
+#endif /* SCHEDULER_READYBITMAP */
+#ifdef TASK_ARGUMENT
+	void* volatile argument;
+#endif /* TASK_ARGUMENT */
+#ifdef TASK_RESUMABLE
+	uint16_t resumePoint;
+#endif /* TASK_RESUMABLE */
+#ifdef SCHEDULER_EDF
+	uint16_t relativeDeadline;
+	volatile uint16_t deadline;
+#endif /* SCHEDULER_EDF */
+#ifdef TASK_JOIN
+	uint8_t joinCount;
+	uint8_t joinPending;
+#endif /* TASK_JOIN */
+#ifdef TASK_BUDGET
+	taskcounter_t budget;
+	volatile uint8_t overruns;
+#endif /* TASK_BUDGET */
+#ifdef SCHEDULER_AGING
+	uint8_t age;
+#endif /* SCHEDULER_AGING */
 } Task;
 
 extern signed char tasks_size;
 extern Task task_mem[MAXTASKS];
 //extern Task* task_mem;
 
+#ifdef TASK_STATISTICS
+/**
+ * Task statistics structure, one per task in taskStatistics_mem
+ * Fields:
+ *  activations: the number of times the task was scheduled while inactive
+ *  dispatches: the number of times the task function was executed
+ *  executionTime: the sum of the execution times of the task function
+ *  maxExecutionTime: the longest execution time of the task function
+ *  maxLatency: the longest time from the activation to the first execution
+ *  scheduledAt: the counter at the last activation
+ *  isWaiting: 1 from the activation to the first execution
+ * the counts stop at 0xFFFF, executionTime and maxExecutionTime stop with dispatches
+ * (as the Stopwatch). the times are in counts of the free running counter,
+ * the execution time includes interrupts and tasks preempting the task
+ *
+ * MEMORY:
+ *  this structure takes up 16 Bytes (26 Bytes with STOPWATCH_32BIT), including 1 Byte of padding
+ */
+typedef struct TaskStatistics_t {
+	uint16_t activations;
+	uint16_t dispatches;
+	taskcountersum_t executionTime;
+	taskcounter_t maxExecutionTime;
+	taskcounter_t maxLatency;
+	volatile taskcounter_t scheduledAt;
+	volatile RSOS_bool isWaiting;
+} TaskStatistics;
+
+extern TaskStatistics taskStatistics_mem[MAXTASKS];
+
+/**
+ * @param task: the task
+ * @return the statistics of the task
+ */
+static inline TaskStatistics* Task_getStatistics(Task* task) __attribute__((always_inline));
+static inline TaskStatistics* Task_getStatistics(Task* task)
+{
+	return &taskStatistics_mem[task - task_mem];
+}
+
+/**
+ * records the activation of a task, called by scheduleTask()
+ * @param task: the task that becomes active
+ */
+static inline void Task_statisticsActivated(Task* task) __attribute__((always_inline));
+static inline void Task_statisticsActivated(Task* task)
+{
+	TaskStatistics* statistics = Task_getStatistics(task);
+	if (statistics->activations != 0xFFFF)
+	{
+		statistics->activations += 1;
+	}
+	statistics->scheduledAt = getFreeRunningCounter();
+	statistics->isWaiting = RSOS_bool_true;
+}
+
+/**
+ * resets the statistics of a task
+ * @param task: the task, 0 to reset the statistics of all tasks
+ */
+__EXTERN_C
+void Task_resetStatistics(Task* task);
+#endif /* TASK_STATISTICS */
+
+#ifdef SCHEDULER_READYBITMAP
+/**
+ * bit n is set if the ready list of priority n contains tasks
+ */
+extern volatile uint16_t task_readyPriorities;
+
+/**
+ * first and last task number of the ready list for each priority, -1 if empty
+ */
+extern volatile int8_t task_readyHead[priorityMask + 1];
+extern volatile int8_t task_readyTail[priorityMask + 1];
+#endif /* SCHEDULER_READYBITMAP */
+
 /**
  * shows the task number currently running
  */
 extern int8_t currentRunningTask;
 
+#ifdef TASK_RESUMABLE
+/**
+ * resumable task functions:
+ *
+ * void longOperation() {
+ *     TASK_BEGIN();
+ *     while (stepsLeft()) {
+ *         doStep();
+ *         TASK_YIELD();        // returns, the next run continues here
+ *     }
+ *     TASK_END();
+ * }
+ *
+ * a task that yields stays active, the scheduler runs higher priority tasks
+ * in between, tasks of lower priority wait until the task has ended.
+ * the resume point is the source line (switch / case), so:
+ *  - local variables are not kept over a yield, use static or structure memory
+ *  - TASK_YIELD() may not be used inside a switch statement of the task function
+ *  - only one TASK_YIELD() per source line
+ */
+
+/**
+ * starts the resumable part of a task function, jumps to the last resume point
+ */
+#define TASK_BEGIN() \
+    { uint16_t* task_resumePoint = &task_mem[currentRunningTask].resumePoint; \
+    switch (*task_resumePoint) { case 0:
+
+/**
+ * returns from the task function, the task stays active and continues
+ * after this statement on its next run
+ */
+#define TASK_YIELD() \
+    do { *task_resumePoint = __LINE__; return; case __LINE__:; } while (0)
+
+/**
+ * yields until the condition is true, the condition is checked on every run
+ */
+#define TASK_WAIT_UNTIL(_condition) \
+    do { *task_resumePoint = __LINE__; case __LINE__: if (!(_condition)) return; } while (0)
+
+/**
+ * ends the resumable part, the next run starts at TASK_BEGIN()
+ * and the task is unscheduled (or counts its cycle) as a regular task
+ */
+#define TASK_END() \
+    } *task_resumePoint = 0; }
+#endif /* TASK_RESUMABLE */
+
 /**
  * shows the priority of the current running task
  */
@@ -150,6 +529,28 @@ extern uint8_t currentPriority;
  */
 extern uint8_t numberOfRunningTasks;
 
+/**
+ * the number of timer ticks since start, counted by Timer_ISR()
+ * (in tickless operation, updated when the waitScheduler runs)
+ */
+extern volatile uint32_t rsos_tickCount;
+
+/**
+ * returns the number of timer ticks since start.
+ * the counter is 32 Bit wide and read twice to be consistent
+ * if an interrupt increments it in between
+ * @return the tick count
+ */
+static inline uint32_t RSOS_now() __attribute__((always_inline));
+static inline uint32_t RSOS_now()
+{
+    uint32_t now;
+    do {
+        now = rsos_tickCount;
+    } while (now != rsos_tickCount);
+    return now;
+}
+
 /**
  * adds a task to the task array
  * @param unsigned int priority: defines the priority of this task. if the task becomes active and has higher
@@ -173,6 +574,21 @@ Task* addTask(unsigned char priority, TaskFunction* taskfunction);
 __EXTERN_C
 void addFollowUpTask(Task* task, Task* *followUpArray, Task* followUpTask);
 
+#ifdef TASK_JOIN
+/**
+ * adds a join task to a predecessor task: the join task is scheduled when all of its
+ * predecessors are completed, not when one of them is. Call it once per predecessor.
+ * the join task takes up one follow up place in each predecessor (@see addFollowUpTask()),
+ * do not add the join task with addFollowUpTask() as well.
+ * scheduleTask() schedules the join task at once, the counting is not changed
+ * @param task: the predecessor task
+ * @param followUpArray: the follow up array of the predecessor, @see addFollowUpTask()
+ * @param joinTask: the task to schedule when all predecessors are completed
+ */
+__EXTERN_C
+void addJoinTask(Task* task, Task* *followUpArray, Task* joinTask);
+#endif /* TASK_JOIN */
+
 /**
  * sets a task cyclic, so it is executed more than once if it becomes active
  * @param task: the position of the task in the tasks-array
@@ -189,6 +605,55 @@ void setTaskCyclic(Task* task, char cycles);
 __EXTERN_C
 void setTaskDelay(Task* task, char delay);
 
+#ifdef TASK_BUDGET
+/**
+ * function of the application called on an overrun
+ * @param taskNumber: the number of the task in task_mem
+ * @param executionTime: the execution time so far
+ * @param isRunning: RSOS_bool_true if the task is still running (called by Task_checkBudget()
+ *        in an interrupt routine, keep it short), RSOS_bool_false if it has returned
+ */
+typedef void (TaskOverrunHook) (int8_t taskNumber, taskcounter_t executionTime, RSOS_bool isRunning);
+
+/**
+ * the number of overruns of all tasks (stops at 0xFFFF)
+ */
+extern volatile uint16_t task_overruns;
+
+/**
+ * sets the execution time budget of a task
+ * @param task: the position of the task in the tasks-array
+ * @param budget: the longest execution time in counts of getFreeRunningCounter(), 0 for no budget
+ */
+__EXTERN_C
+void setTaskBudget(Task* task, taskcounter_t budget);
+
+/**
+ * sets the function called on an overrun, once per execution of the task
+ * @param hook: the function, 0 for none
+ */
+__EXTERN_C
+void Task_setOverrunHook(TaskOverrunHook* hook);
+
+/**
+ * checks the budget of the running task, to be called in a timer interrupt routine
+ * (Timer_ISR() calls it). an overrun is reported at once, the task is not stopped
+ */
+__EXTERN_C
+void Task_checkBudget();
+#endif /* TASK_BUDGET */
+
+#ifdef SCHEDULER_EDF
+/**
+ * sets the relative deadline of a task (SCHEDULER_EDF)
+ * @param task: the position of the task in the tasks-array
+ * @param deadline: the number of timer ticks after the task is scheduled
+ *        it should be completed in (1 to Task_noDeadline)
+ */
+__EXTERN_C
+void setTaskDeadline(Task* task, uint16_t deadline);
+#endif /* SCHEDULER_EDF */
+
 /**
  * set a new delay to the current running task,
  * must only be called within the task function
@@ -241,6 +706,32 @@ static inline void Task_resetDelayState()
 	}
 }
 
+#ifdef SCHEDULER_READYBITMAP
+/**
+ * appends a task to the ready list of its priority.
+ * only to be called internally with interrupts disabled
+ * @param task: the task to append
+ */
+static inline void Task_readyListAppend(Task* task) __attribute__((always_inline));
+static inline void Task_readyListAppend(Task* task)
+{
+    uint8_t prio = task->status & priorityMask;
+    int8_t taskNr = task - task_mem;
+
+    task->nextReady = -1;
+    if (task_readyTail[prio] == -1)
+    {
+        task_readyHead[prio] = taskNr;
+    }
+    else
+    {
+        task_mem[task_readyTail[prio]].nextReady = taskNr;
+    }
+    task_readyTail[prio] = taskNr;
+    task_readyPriorities |= (1 << prio);
+}
+#endif /* SCHEDULER_READYBITMAP */
+
 /**
  * sets a task active, it is executed when the scheduler is working
  * This function disables and enables all interrupts within execution
@@ -249,14 +740,41 @@ static inline void Task_resetDelayState()
 static inline void scheduleTask(Task* task) __attribute__((always_inline));
 static inline void scheduleTask(Task* task)
 {
-#ifdef NEWSCHEDULER
+#ifdef TASK_ARGUMENT
+    task->argument = 0;         // the caller is unknown
+#endif /* TASK_ARGUMENT */
+#ifdef SCHEDULER_READYBITMAP
+    uint16_t interruptState = enterCritical();
+    if (!(task->status & Task_isActive))
+    {
+#ifdef TASK_STATISTICS
+        Task_statisticsActivated(task);
+#endif /* TASK_STATISTICS */
+        TRACE(TRACE_TASK_SCHEDULED, task - task_mem);
+        task->status |= Task_isActive;
+        numberOfRunningTasks += 1;
+        Task_readyListAppend(task);
+    }
+    exitCritical(interruptState);
+#elif defined NEWSCHEDULER
     if (!(task->status & Task_isActive))
     {
+#ifdef SCHEDULER_EDF
+        task->deadline = (uint16_t)rsos_tickCount + task->relativeDeadline;
+#endif /* SCHEDULER_EDF */
+#ifdef TASK_STATISTICS
+        Task_statisticsActivated(task);
+#endif /* TASK_STATISTICS */
+        TRACE(TRACE_TASK_SCHEDULED, task - task_mem);
         task->status |= Task_isActive;
     }
 #else
     if (!(task->status & Task_isActive))
     {
+#ifdef TASK_STATISTICS
+        Task_statisticsActivated(task);
+#endif /* TASK_STATISTICS */
+        TRACE(TRACE_TASK_SCHEDULED, task - task_mem);
         task->status |= Task_isActive;
         numberOfRunningTasks += 1;
 
@@ -265,9 +783,44 @@ static inline void scheduleTask(Task* task)
             currentPriority = (task->status & priorityMask);        //maximum priority of running task
         }
     }
-#endif /* NEWSCHEDULER */
+#endif /* SCHEDULER_READYBITMAP */
 }
 
+#ifdef TASK_ARGUMENT
+/**
+ * sets a task active with an argument, it is read by the task with Task_getArgument().
+ * if the task is already active with another argument, the argument is set to 0:
+ * the task is activated by more than one object and has to find them itself
+ * @param task: pointer to the task that should be scheduled
+ * @param argument: the argument, for example the object that activates the task
+ */
+static inline void scheduleTaskWithArg(Task* task, void* argument) __attribute__((always_inline));
+static inline void scheduleTaskWithArg(Task* task, void* argument)
+{
+    uint16_t interruptState = enterCritical();
+    if (!(task->status & Task_isActive))
+    {
+        scheduleTask(task);
+        task->argument = argument;
+    }
+    else if (task->argument != argument)
+    {
+        task->argument = 0;
+    }
+    exitCritical(interruptState);
+}
+
+/**
+ * to be called in the running task function
+ * @return the argument the running task was scheduled with, 0 if it is unknown
+ */
+static inline void* Task_getArgument() __attribute__((always_inline));
+static inline void* Task_getArgument()
+{
+    return task_mem[currentRunningTask].argument;
+}
+#endif /* TASK_ARGUMENT */
+
 /**
  * sets the scheduler enabled, the scheduler is running continuously
  */
@@ -289,5 +842,21 @@ void disableScheduler();
 __EXTERN_C
 void scheduler();
 
+#ifdef SCHEDULER_PREEMPTIVE
+/**
+ * executes the active tasks with a higher priority than the running task.
+ * to be called at the end of an interrupt routine that scheduled a task,
+ * the running task continues when the function returns.
+ * if no task function is running (the scheduler is between two tasks or waits),
+ * the function returns at once, the scheduler executes the tasks itself.
+ *
+ * the tasks are executed with interrupts enabled (preemptSchedulerEntered()),
+ * so they can be preempted as well by tasks of even higher priority.
+ * a delayed task counts one delay cycle per call
+ */
+__EXTERN_C
+void schedulerPreempt();
+#endif /* SCHEDULER_PREEMPTIVE */
+
 
 #endif /* TASK_H_ */
@@ -0,0 +1,63 @@
+/*
+ * Trace.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include "Trace.h"
+
+/* exclude everything if not used */
+#ifdef MAXTRACEEVENTS
+
+TraceEvent traceEvent_mem[MAXTRACEEVENTS];
+volatile uint16_t trace_count = 0;
+volatile RSOS_bool trace_isEnabled = RSOS_bool_true;
+
+void Trace_clear()
+{
+    uint16_t interruptState = enterCritical();
+    trace_count = 0;
+    exitCritical(interruptState);
+}
+
+/**
+ * writes a 16 Bit value, low byte first
+ */
+static inline void Trace_output16(TraceOutput* output, uint16_t value) __attribute__((always_inline));
+static inline void Trace_output16(TraceOutput* output, uint16_t value)
+{
+    output(value & 0xFF);
+    output(value >> 8);
+}
+
+void Trace_dump(TraceOutput* output)
+{
+    RSOS_bool wasEnabled = trace_isEnabled;
+    trace_isEnabled = RSOS_bool_false;
+
+    uint16_t count = trace_count;
+    uint16_t number = (count < MAXTRACEEVENTS) ? count : MAXTRACEEVENTS;
+    uint16_t i;
+
+    output('R');
+    output('S');
+    output('T');
+    output('R');
+    output(1);                                  // version
+    output(sizeof(traceEvent_mem[0].timestamp));
+    Trace_output16(output, number);
+    Trace_output16(output, count - number);     // overwritten
+
+    for (i = count - number; i != count; i++)
+    {
+        TraceEvent* event = &traceEvent_mem[i & Trace_indexMask];
+        Trace_output16(output, event->timestamp);
+        output(event->type);
+        output(event->data);
+    }
+
+    trace_isEnabled = wasEnabled;
+}
+
+#endif /* MAXTRACEEVENTS */
@@ -0,0 +1,235 @@
+/*
+ * Trace.h
+ *
+ * event trace recorder: a ring buffer of small binary events, stamped with the
+ * free running counter. the ring always holds the last MAXTRACEEVENTS events,
+ * so it can stay enabled and be read out when something went wrong.
+ *
+ * recorded events (TRACE_...):
+ *  - task scheduled, task begin / end (scheduler())
+ *  - scheduler idle begin / end (schedulerWait())
+ *  - waitScheduler begin / end and the expired timers
+ *  - buttonWaitScheduler begin / end
+ *  - SPI and I2C transfer begin / end / error
+ *  - task budget overruns (TASK_BUDGET)
+ *  - events of the application (TRACE_USER, Trace_record())
+ *
+ * operation:
+ *      1.  the modules record events with TRACE(), it is empty if MAXTRACEEVENTS is not defined
+ *      2.  Trace_dump() writes the recorded events, oldest first, byte by byte to a function
+ *          of the application, for example to the UART
+ *      3.  on the host, tools/TraceToJson converts the dump to the Chrome trace format
+ *          (chrome://tracing, ui.perfetto.dev)
+ *
+ * dump format (little endian):
+ *      "RSTR", version (1 Byte), counter size in Bytes (1 Byte),
+ *      number of events (2 Bytes), number of events overwritten (2 Bytes, exact up to 65535 - MAXTRACEEVENTS),
+ *      then per event: timestamp (2 Bytes), type (1 Byte), data (1 Byte)
+ *
+ * the HardwareAdaptionLayer must provide enterCritical() / exitCritical() and
+ * getFreeRunningCounter() (@see Stopwatch.h), only the lower 16 Bit are recorded
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <RSOSDefines.h>
+
+/* exclude everything if not used */
+#ifdef MAXTRACEEVENTS
+
+#if (MAXTRACEEVENTS & (MAXTRACEEVENTS - 1)) != 0
+#error "MAXTRACEEVENTS must be a power of 2"
+#endif
+
+#include <stdint.h>
+
+#include <HardwareAdaptionLayer.h>
+#include "RSOS_BasicInclude.h"
+
+/**
+ * a task is scheduled (becomes active), data: task number
+ */
+#define TRACE_TASK_SCHEDULED 0x01
+
+/**
+ * the task function is called, data: task number
+ */
+#define TRACE_TASK_BEGIN 0x02
+
+/**
+ * the task function returned, data: task number
+ */
+#define TRACE_TASK_END 0x03
+
+/**
+ * the scheduler waits for an interrupt (schedulerWait())
+ */
+#define TRACE_IDLE_BEGIN 0x04
+
+/**
+ * the scheduler continues after schedulerWait()
+ */
+#define TRACE_IDLE_END 0x05
+
+/**
+ * the waitScheduler starts
+ */
+#define TRACE_TIMER_BEGIN 0x06
+
+/**
+ * the waitScheduler ends
+ */
+#define TRACE_TIMER_END 0x07
+
+/**
+ * a WaitTimer expired, data: timer number
+ */
+#define TRACE_TIMER_EXPIRED 0x08
+
+/**
+ * the buttonWaitScheduler starts
+ */
+#define TRACE_BUTTONS_BEGIN 0x09
+
+/**
+ * the buttonWaitScheduler ends
+ */
+#define TRACE_BUTTONS_END 0x0A
+
+/**
+ * an SPI transfer is activated, data: SPIOperation number
+ */
+#define TRACE_SPI_BEGIN 0x0B
+
+/**
+ * the bytes of an SPI transfer are transferred, data: SPIOperation number
+ */
+#define TRACE_SPI_END 0x0C
+
+/**
+ * an I2C transfer is activated, data: I2C_Data number
+ */
+#define TRACE_I2C_BEGIN 0x0D
+
+/**
+ * an I2C transfer is completed, data: I2C_Data number
+ */
+#define TRACE_I2C_END 0x0E
+
+/**
+ * an I2C transfer is aborted, data: I2C_Data number (0xFF if none is active)
+ */
+#define TRACE_I2C_ERROR 0x0F
+
+/**
+ * a task exceeded its execution time budget (TASK_BUDGET), data: task number
+ */
+#define TRACE_TASK_OVERRUN 0x10
+
+/**
+ * first event type of the application, the types TRACE_USER to 0xFF are free
+ */
+#define TRACE_USER 0x80
+
+/**
+ * mask for the ring index
+ */
+#define Trace_indexMask (MAXTRACEEVENTS - 1)
+
+/**
+ * Trace event structure
+ * Fields:
+ *  timestamp: the lower 16 Bit of the free running counter
+ *  type: the event type, TRACE_...
+ *  data: the task, timer, ... number or data of the application
+ *
+ * MEMORY:
+ *  this structure takes up 4 Bytes
+ */
+typedef struct TraceEvent_t {
+    uint16_t timestamp;
+    uint8_t type;
+    uint8_t data;
+} TraceEvent;
+
+extern TraceEvent traceEvent_mem[MAXTRACEEVENTS];
+
+/**
+ * the number of recorded events, the next event is written to
+ * traceEvent_mem[trace_count & Trace_indexMask]
+ */
+extern volatile uint16_t trace_count;
+
+/**
+ * RSOS_bool_true while events are recorded
+ */
+extern volatile RSOS_bool trace_isEnabled;
+
+/**
+ * the function Trace_dump() writes the bytes to
+ */
+typedef void (TraceOutput) (uint8_t);
+
+/**
+ * records an event, may be called in an interrupt routine
+ * @param type: the event type, TRACE_... or TRACE_USER and above
+ * @param data: the data of the event
+ */
+static inline void Trace_record(uint8_t type, uint8_t data) __attribute__((always_inline));
+static inline void Trace_record(uint8_t type, uint8_t data)
+{
+    if (trace_isEnabled)
+    {
+        uint16_t interruptState = enterCritical();
+        TraceEvent* event = &traceEvent_mem[trace_count & Trace_indexMask];
+        event->timestamp = (uint16_t)getFreeRunningCounter();
+        event->type = type;
+        event->data = data;
+        trace_count += 1;
+        if (trace_count == 0)
+        {
+            trace_count = MAXTRACEEVENTS;   // the ring stays full, same index
+        }
+        exitCritical(interruptState);
+    }
+}
+
+/**
+ * starts or stops recording, recording is started at reset
+ * @param enable: RSOS_bool_true to record events
+ */
+static inline void Trace_enable(RSOS_bool enable) __attribute__((always_inline));
+static inline void Trace_enable(RSOS_bool enable)
+{
+    trace_isEnabled = enable;
+}
+
+/**
+ * clears all recorded events
+ */
+__EXTERN_C
+void Trace_clear();
+
+/**
+ * writes the recorded events, oldest first, in the dump format.
+ * recording is stopped during the dump and continues afterwards
+ * @param output: the function called for every byte
+ */
+__EXTERN_C
+void Trace_dump(TraceOutput* output);
+
+/**
+ * records an event in the modules of the RSOS
+ */
+#define TRACE(_type, _data) Trace_record((_type), (uint8_t)(_data))
+
+#else
+
+#define TRACE(_type, _data)
+
+#endif /* MAXTRACEEVENTS */
+#endif /* TRACE_H_ */
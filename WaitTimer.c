@@ -7,6 +7,9 @@
 
 #include "WaitTimer.h"
 #include <HardwareAdaptionLayer.h>
+#ifdef MAXDEFERREDWORK
+#include "DeferredWork.h"
+#endif /* MAXDEFERREDWORK */
 
 #ifdef MAXTIMERS
 
@@ -14,6 +17,22 @@
 Task* task_waitScheduler = 0;
 #endif /* WAITTIMER_TASK */
 
+#ifdef WAITTIMER_TICKLESS
+uint16_t waitTimer_lastTick = 0;
+#endif /* WAITTIMER_TICKLESS */
+
+#ifdef WAITTIMER_WHEEL
+volatile waittime_t waitTimer_wheelTime = 0;
+volatile int8_t waitTimer_wheel[2 * WAITTIMER_WHEELSIZE];
+#endif /* WAITTIMER_WHEEL */
+
+#ifdef MAXPERIODICTASKS
+PeriodicTask periodicTask_mem[MAXPERIODICTASKS];
+int8_t periodicTask_size = 0;
+
+volatile uint16_t periodicTask_nextDue = 0x7FFF;
+#endif /* MAXPERIODICTASKS */
+
 void waitScheduler();
 
 void Timer_initOperation()
@@ -21,8 +40,136 @@ void Timer_initOperation()
 #ifdef WAITTIMER_TASK
     task_waitScheduler = addTask(0, waitScheduler);
 #endif /* WAITTIMER_TASK */
+#ifdef WAITTIMER_WHEEL
+    int8_t i;
+    for (i=2*WAITTIMER_WHEELSIZE; i>0; i-=1)
+    {
+        waitTimer_wheel[i-1] = -1;
+    }
+#endif /* WAITTIMER_WHEEL */
+}
+
+#ifdef WAITTIMER_WHEEL
+/**
+ * puts an active timer into the wheel slot of its expiry tick (currentWaitTime)
+ * @param waitTimer: the timer to insert
+ */
+static void Timer_wheelInsert(WaitTimer* waitTimer)
+{
+    waittime_t expiry = waitTimer->currentWaitTime;
+    uint8_t slot;
+
+    uint16_t interruptState = enterCritical();
+    waittime_t delta = expiry - waitTimer_wheelTime;
+    if (delta < WAITTIMER_WHEELSIZE)
+    {
+        slot = expiry & WaitTimer_wheelSlotMask;
+    }
+    else if (delta < WAITTIMER_WHEELSIZE * WAITTIMER_WHEELSIZE)
+    {
+        slot = WaitTimer_wheelLevel1 | ((expiry >> WAITTIMER_WHEELBITS) & WaitTimer_wheelSlotMask);
+    }
+    else
+    {
+        // beyond the wheel's range: the last level 1 slot of this round, the timer is sorted in again from there
+        slot = WaitTimer_wheelLevel1 | (((waitTimer_wheelTime >> WAITTIMER_WHEELBITS) - 1) & WaitTimer_wheelSlotMask);
+    }
+    waitTimer->nextInSlot = waitTimer_wheel[slot];
+    waitTimer_wheel[slot] = waitTimer - waitTimers_mem;
+    waitTimer->slot = slot;
+    exitCritical(interruptState);
+}
+
+/**
+ * sets the expiry tick of a timer and inserts it, in one critical section:
+ * a tick between reading the wheel time and the insert would put the timer
+ * behind the wheel time, it would expire a full round of the wheel time late
+ * @param waitTimer: the timer to start
+ * @param waitTime: the ticks to count down, the timer expires on the tick after
+ * @param withSlack: RSOS_bool_true to round the expiry tick up within the slack of the timer (WAITTIMER_SLACK)
+ */
+static void Timer_wheelStart(WaitTimer* waitTimer, waittime_t waitTime, RSOS_bool withSlack)
+{
+    uint16_t interruptState = enterCritical();
+    waittime_t expiry = waitTimer_wheelTime + waitTime + 1;
+#ifdef WAITTIMER_SLACK
+    if (withSlack)
+    {
+        expiry = (expiry + waitTimer->slackMask) & ~waitTimer->slackMask;
+    }
+#endif /* WAITTIMER_SLACK */
+    waitTimer->currentWaitTime = expiry;
+    Timer_wheelInsert(waitTimer);
+    exitCritical(interruptState);
 }
 
+/**
+ * removes a timer from its wheel slot, nothing is done if the timer is not in the wheel
+ * @param waitTimer: the timer to remove
+ */
+static void Timer_wheelRemove(WaitTimer* waitTimer)
+{
+    uint16_t interruptState = enterCritical();
+    if (waitTimer->slot != WaitTimer_noSlot)
+    {
+        int8_t timerNr = waitTimer - waitTimers_mem;
+        volatile int8_t* link = &waitTimer_wheel[waitTimer->slot];
+        while (*link != -1 && *link != timerNr)
+        {
+            link = &waitTimers_mem[*link].nextInSlot;
+        }
+        if (*link == timerNr)
+        {
+            *link = waitTimer->nextInSlot;
+        }
+        waitTimer->slot = WaitTimer_noSlot;
+    }
+    exitCritical(interruptState);
+}
+
+/**
+ * takes the first timer out of a wheel slot
+ * @param slot: the slot
+ * @return the timer or 0 if the slot is empty
+ */
+static inline WaitTimer* Timer_wheelPop(uint8_t slot) __attribute__((always_inline));
+static inline WaitTimer* Timer_wheelPop(uint8_t slot)
+{
+    WaitTimer* waitTimer = 0;
+    uint16_t interruptState = enterCritical();
+    if (waitTimer_wheel[slot] != -1)
+    {
+        waitTimer = &waitTimers_mem[waitTimer_wheel[slot]];
+        waitTimer_wheel[slot] = waitTimer->nextInSlot;
+        waitTimer->slot = WaitTimer_noSlot;
+    }
+    exitCritical(interruptState);
+    return waitTimer;
+}
+
+void Timer_wheelHalt(WaitTimer* waitTimer)
+{
+    uint16_t interruptState = enterCritical();
+    if (waitTimer->status & WaitTimer_isActive)
+    {
+        Timer_wheelRemove(waitTimer);
+        waitTimer->status &= ~WaitTimer_isActive;
+        waitTimer->currentWaitTime -= waitTimer_wheelTime + 1;
+    }
+    exitCritical(interruptState);
+}
+
+void Timer_wheelContinue(WaitTimer* waitTimer)
+{
+    if (!(waitTimer->status & WaitTimer_isActive))
+    {
+        waitTimer->status |= WaitTimer_isActive;
+        Timer_wheelStart(waitTimer, waitTimer->currentWaitTime, RSOS_bool_false);
+    }
+}
+#endif /* WAITTIMER_WHEEL */
+
+#ifndef WAITTIMER_WIDE
 static inline uint16_t Timer_getExponentAndTime(uint16_t time) __attribute__((always_inline));
 static inline uint16_t Timer_getExponentAndTime(uint16_t time) {
     uint16_t timeCpy = time;
@@ -40,28 +187,147 @@ static inline uint16_t Timer_getExponentAndTime(uint16_t time) {
     return (exponent | timeCpy);
 }
 
-WaitTimer* initWaitTimer(uint16_t waitTime)
+#endif /* WAITTIMER_WIDE */
+
+WaitTimer* initWaitTimer(waittime_t waitTime)
 {
 	waitTimers_mem[timers_size].status = 0;
+#ifdef WAITTIMER_WIDE
+	waitTimers_mem[timers_size].waitTime = waitTime;
+#else
 	waitTimers_mem[timers_size].status |= Timer_getExponentAndTime(waitTime);
+#endif /* WAITTIMER_WIDE */
 	waitTimers_mem[timers_size].currentWaitTime = 0;
 	waitTimers_mem[timers_size].taskOnStart = -1;
 	waitTimers_mem[timers_size].taskOnStop = -1;
+#ifdef WAITTIMER_SLACK
+	waitTimers_mem[timers_size].slackMask = 0;
+#endif /* WAITTIMER_SLACK */
+#ifdef WAITTIMER_SUBSCRIBERS
+	waitTimers_mem[timers_size].subscribers = 0;
+	waitTimers_mem[timers_size].numberOfSubscribers = 0;
+#endif /* WAITTIMER_SUBSCRIBERS */
+#ifdef WAITTIMER_CALLBACK
+	waitTimers_mem[timers_size].callbackOnStop = 0;
+	waitTimers_mem[timers_size].callbackArgument = 0;
+#endif /* WAITTIMER_CALLBACK */
+#ifdef WAITTIMER_WHEEL
+	waitTimers_mem[timers_size].nextInSlot = -1;
+	waitTimers_mem[timers_size].slot = WaitTimer_noSlot;
+#endif /* WAITTIMER_WHEEL */
 	timers_size += 1;
 	return &waitTimers_mem[timers_size-1];
 }
 
-static inline void stopTimer(WaitTimer* waitTimer) __attribute__((always_inline));
-static inline void stopTimer(WaitTimer* waitTimer) {
+#ifdef WAITTIMER_SLACK
+WaitTimer* initWaitTimer_slack(waittime_t waitTime, uint8_t slack)
+{
+	WaitTimer* waitTimer = initWaitTimer(waitTime);
+	setTimerSlack(waitTimer, slack);
+	return waitTimer;
+}
+
+void setTimerSlack(WaitTimer* waitTimer, uint8_t slack)
+{
+	uint16_t alignment = 1;
+	while ((alignment << 1) <= (uint16_t)slack + 1)	//largest power of two not bigger than slack + 1
+	{
+		alignment <<= 1;
+	}
+	waitTimer->slackMask = alignment - 1;
+}
+
+/**
+ * delays the expiry of a just started timer within its slack,
+ * the expiry tick is rounded up to a multiple of (slackMask + 1)
+ * @param waitTimer: the timer, currentWaitTime is set
+ */
+static inline void Timer_applySlack(WaitTimer* waitTimer) __attribute__((always_inline));
+static inline void Timer_applySlack(WaitTimer* waitTimer) {
+    waittime_t mask = waitTimer->slackMask;
+    // currentWaitTime counts down to the tick after rsos_tickCount + currentWaitTime
+    waittime_t expiry = (waittime_t)RSOS_now() + waitTimer->currentWaitTime + 1;
+    waitTimer->currentWaitTime += ((expiry + mask) & ~mask) - expiry;
+}
+#endif /* WAITTIMER_SLACK */
+
+/**
+ * returns the wait time of the timer
+ * @param waitTimer: the timer
+ * @return the wait time in ticks
+ */
+static inline waittime_t Timer_getWaitTime(WaitTimer* waitTimer) __attribute__((always_inline));
+static inline waittime_t Timer_getWaitTime(WaitTimer* waitTimer) {
+#ifdef WAITTIMER_WIDE
+    return waitTimer->waitTime;
+#else
+    switch (waitTimer->status & exponentMask) {
+    case WaitTimer_exponent_2: return (waitTimer->status & timer_waitTimeMask) << 2;
+    case WaitTimer_exponent_4: return (waitTimer->status & timer_waitTimeMask) << 4;
+    default: return waitTimer->status & timer_waitTimeMask;
+    }
+#endif /* WAITTIMER_WIDE */
+}
+
+/**
+ * starts a cyclic timer again, the next expiry is one period after the last expiry tick
+ * @param waitTimer: the timer that expired
+ * @param overdue: the number of ticks passed since the expiry tick
+ */
+static inline void Timer_restartCyclic(WaitTimer* waitTimer, uint16_t overdue) __attribute__((always_inline));
+static inline void Timer_restartCyclic(WaitTimer* waitTimer, uint16_t overdue) {
+    waittime_t period = Timer_getWaitTime(waitTimer);
+    if (period == 0) {
+        period = 1;
+    }
+    while (overdue >= period) {         //skip the missed periods
+        overdue -= period;
+    }
+
+    if (waitTimer->taskOnStart != -1) {
+        scheduleTask(&task_mem[waitTimer->taskOnStart]);
+    }
+    waitTimer->status |= WaitTimer_isActive;
+#ifdef WAITTIMER_WHEEL
+    Timer_wheelStart(waitTimer, period - 1, RSOS_bool_true);
+#else
+    waitTimer->currentWaitTime = period - 1 - overdue;
+#ifdef WAITTIMER_SLACK
+    Timer_applySlack(waitTimer);
+#endif /* WAITTIMER_SLACK */
+#endif /* WAITTIMER_WHEEL */
+}
+
+/**
+ * stops an expired timer and schedules the task on stop,
+ * a cyclic timer is started again
+ * @param waitTimer: the timer that expired
+ * @param overdue: the number of ticks passed since the expiry tick
+ */
+static inline void stopTimer(WaitTimer* waitTimer, uint16_t overdue) __attribute__((always_inline));
+static inline void stopTimer(WaitTimer* waitTimer, uint16_t overdue) {
+    TRACE(TRACE_TIMER_EXPIRED, waitTimer - waitTimers_mem);
     if (waitTimer->taskOnStop != -1) {
         scheduleTask(&task_mem[waitTimer->taskOnStop]);
     }
+#ifdef WAITTIMER_SUBSCRIBERS
+    uint8_t i;
+    for (i=waitTimer->numberOfSubscribers; i>0; i-=1) {
+        scheduleTask(waitTimer->subscribers[i-1]);
+    }
+#endif /* WAITTIMER_SUBSCRIBERS */
 
     waitTimer->status &= ~WaitTimer_isActive;
 
     if (waitTimer->status & WaitTimer_isCyclicTimer) {
-        setTimer(waitTimer);
+        Timer_restartCyclic(waitTimer, overdue);
+    }
+
+#ifdef WAITTIMER_CALLBACK
+    if (waitTimer->callbackOnStop != 0) {
+        waitTimer->callbackOnStop(waitTimer->callbackArgument);
     }
+#endif /* WAITTIMER_CALLBACK */
 }
 
 void setTaskOnStart(WaitTimer* waitTimer, Task* task)
@@ -74,8 +340,46 @@ void setTaskOnStop(WaitTimer* waitTimer, Task* task)
 	waitTimer->taskOnStop = getTaskNumber(task);
 }
 
-void setNewWaitTime(uint16_t waitTime, WaitTimer* waitTimer)
+#ifdef WAITTIMER_SUBSCRIBERS
+RSOS_ret addSubscriberOnStop(WaitTimer* waitTimer, Task* *subscriberArray, Task* task)
+{
+	if (waitTimer->numberOfSubscribers >= WAITTIMER_MAXSUBSCRIBERS)
+	{
+		return RSOS_ret_ERROR;
+	}
+	if (waitTimer->numberOfSubscribers == 0)
+	{
+		if (subscriberArray == 0)
+		{
+			return RSOS_ret_ERROR;
+		}
+		waitTimer->subscribers = subscriberArray;
+	}
+	waitTimer->subscribers[waitTimer->numberOfSubscribers] = task;
+	waitTimer->numberOfSubscribers += 1;
+	return RSOS_ret_OK;
+}
+#endif /* WAITTIMER_SUBSCRIBERS */
+
+#ifdef WAITTIMER_CALLBACK
+void setCallbackOnStop(WaitTimer* waitTimer, WaitTimerCallback* callback, void* argument)
 {
+	waitTimer->callbackOnStop = 0;      // not called from the ISR while the argument is changed
+	waitTimer->callbackArgument = argument;
+	waitTimer->callbackOnStop = callback;
+}
+#endif /* WAITTIMER_CALLBACK */
+
+void setNewWaitTime(waittime_t waitTime, WaitTimer* waitTimer)
+{
+#ifdef WAITTIMER_WHEEL
+	if (waitTimer->status & WaitTimer_isActive)
+	{
+		Timer_wheelRemove(waitTimer);
+		Timer_wheelStart(waitTimer, waitTime, RSOS_bool_false);
+		return;
+	}
+#endif /* WAITTIMER_WHEEL */
 	waitTimer->currentWaitTime = waitTime;
 }
 
@@ -92,18 +396,217 @@ void setTimer(WaitTimer* waitTimer)
         {
             scheduleTask(&task_mem[waitTimer->taskOnStart]);
         }
-        switch (waitTimer->status & exponentMask) {
-        case WaitTimer_exponent_0: waitTimer->currentWaitTime = waitTimer->status & timer_waitTimeMask; break;
-        case WaitTimer_exponent_2: waitTimer->currentWaitTime = (waitTimer->status & timer_waitTimeMask) << 2; break;
-        case WaitTimer_exponent_4: waitTimer->currentWaitTime = (waitTimer->status & timer_waitTimeMask) << 4; break;
-        }
+        waitTimer->currentWaitTime = Timer_getWaitTime(waitTimer);
+#ifdef WAITTIMER_TICKLESS
+        // the wait time refers to the last tick processed by the waitScheduler
+        waitTimer->currentWaitTime += getTickCount() - waitTimer_lastTick;
+#endif /* WAITTIMER_TICKLESS */
         waitTimer->status |= WaitTimer_isActive;
+#ifdef WAITTIMER_WHEEL
+        Timer_wheelStart(waitTimer, waitTimer->currentWaitTime, RSOS_bool_true);
+#elif defined(WAITTIMER_SLACK)
+        Timer_applySlack(waitTimer);
+#endif /* WAITTIMER_WHEEL */
+    }
+}
+
+#ifdef MAXPERIODICTASKS
+PeriodicTask* initPeriodicTask(Task* task, uint16_t period)
+{
+    periodicTask_mem[periodicTask_size].period = (period != 0) ? period : 1;
+    periodicTask_mem[periodicTask_size].nextRelease = 0;
+    periodicTask_mem[periodicTask_size].task = getTaskNumber(task);
+    periodicTask_mem[periodicTask_size].status = 0;
+
+    periodicTask_size += 1;
+    return &periodicTask_mem[periodicTask_size - 1];
+}
+
+void PeriodicTask_start(PeriodicTask* periodicTask, uint16_t phase)
+{
+    uint16_t interruptState = enterCritical();
+    if (!(periodicTask->status & PeriodicTask_isActive))
+    {
+        periodicTask->nextRelease = (uint16_t)rsos_tickCount + ((phase != 0) ? phase : 1);
+#ifdef WAITTIMER_TICKLESS
+        // rsos_tickCount is only counted up to the last tick processed by the waitScheduler
+        periodicTask->nextRelease += getTickCount() - waitTimer_lastTick;
+#endif /* WAITTIMER_TICKLESS */
+        periodicTask->status |= PeriodicTask_isActive;
+
+        if ((int16_t)(periodicTask->nextRelease - periodicTask_nextDue) < 0)
+        {
+            periodicTask_nextDue = periodicTask->nextRelease;
+        }
+    }
+    exitCritical(interruptState);
+}
+
+void PeriodicTask_stop(PeriodicTask* periodicTask)
+{
+    // periodicTask_nextDue is not changed, the next release finds nothing to do and corrects it
+    periodicTask->status &= ~PeriodicTask_isActive;
+}
+
+void PeriodicTask_release()
+{
+    uint16_t now = (uint16_t)rsos_tickCount;
+    uint16_t nextDue = now + 0x7FFF;       // check at least every half counter period
+    int8_t i;
+
+    // PeriodicTask_start() may change periodicTask_nextDue in an interrupt
+    uint16_t interruptState = enterCritical();
+    for (i=periodicTask_size; i>0; i-=1)
+    {
+        PeriodicTask* pT = &periodicTask_mem[i-1];
+        if (pT->status & PeriodicTask_isActive)
+        {
+            if ((int16_t)(now - pT->nextRelease) >= 0)
+            {
+                scheduleTask(&task_mem[pT->task]);
+                do {                                    //skip the missed periods
+                    pT->nextRelease += pT->period;
+                } while ((int16_t)(now - pT->nextRelease) >= 0);
+            }
+            if ((int16_t)(pT->nextRelease - nextDue) < 0)
+            {
+                nextDue = pT->nextRelease;
+            }
+        }
+    }
+    periodicTask_nextDue = nextDue;
+    exitCritical(interruptState);
+}
+#endif /* MAXPERIODICTASKS */
+
+#ifdef WAITTIMER_TICKLESS
+void waitScheduler()
+{
+	waitSchedulerEntered();
+	TRACE(TRACE_TIMER_BEGIN, 0);
+
+	uint16_t now = getTickCount();
+	uint16_t elapsed = now - waitTimer_lastTick;
+	waitTimer_lastTick = now;
+	rsos_tickCount += elapsed;
+#ifdef MAXPERIODICTASKS
+	PeriodicTask_tick();
+#endif /* MAXPERIODICTASKS */
+
+	signed char i;
+	WaitTimer* wT;
+	for (i=timers_size; i>0; i--)
+	{
+		wT = &waitTimers_mem[i-1];
+		if (wT->status & WaitTimer_isActive)
+		{
+			if (wT->currentWaitTime >= elapsed)
+			{
+				wT->currentWaitTime -= elapsed;
+			}
+			else
+			{
+			    stopTimer(wT, elapsed - wT->currentWaitTime - 1);
+			}
+		}
+	}
+
+	TRACE(TRACE_TIMER_END, 0);
+	waitSchedulerExited();
+}
+
+void Timer_setNextWakeup()
+{
+    uint16_t nextWakeup = 0xFFFF;      // wake up at least once per counter period
+
+    if (numberOfRunningTasks != 0)
+    {
+        nextWakeup = 1;                 // delayed tasks count scheduler cycles
     }
+#ifdef MAXDEFERREDWORK
+    else if (DeferredWork_isPending())
+    {
+        nextWakeup = 1;                 // work posted after the last drain
+    }
+#endif /* MAXDEFERREDWORK */
+    else
+    {
+        signed char i;
+        for (i=timers_size; i>0; i--)
+        {
+            WaitTimer* wT = &waitTimers_mem[i-1];
+            if ((wT->status & WaitTimer_isActive) && wT->currentWaitTime < nextWakeup)
+            {
+                nextWakeup = wT->currentWaitTime + 1;
+            }
+        }
+#ifdef MAXPERIODICTASKS
+        int16_t untilDue = periodicTask_nextDue - (uint16_t)rsos_tickCount;
+        if (untilDue < 1)
+        {
+            untilDue = 1;
+        }
+        if ((uint16_t)untilDue < nextWakeup)
+        {
+            nextWakeup = untilDue;
+        }
+#endif /* MAXPERIODICTASKS */
+    }
+
+    // the tasks may have run for a while since the last waitScheduler(),
+    // a wakeup in the past would only be reached after the counter wrapped
+    uint16_t elapsed = getTickCount() - waitTimer_lastTick;
+    if (nextWakeup <= elapsed)
+    {
+        nextWakeup = elapsed + 1;
+    }
+    setTickWakeup(waitTimer_lastTick + nextWakeup);
 }
+#elif defined WAITTIMER_WHEEL
+void waitScheduler()
+{
+	waitSchedulerEntered();
+	TRACE(TRACE_TIMER_BEGIN, 0);
+
+	waittime_t now = waitTimer_wheelTime + 1;
+	waitTimer_wheelTime = now;
+	WaitTimer* wT;
+
+	if ((now & WaitTimer_wheelSlotMask) == 0)
+	{
+		// move the timers of the next level 1 slot down to level 0
+		uint8_t cascadeSlot = WaitTimer_wheelLevel1 | ((now >> WAITTIMER_WHEELBITS) & WaitTimer_wheelSlotMask);
+		for (wT = Timer_wheelPop(cascadeSlot); wT != 0; wT = Timer_wheelPop(cascadeSlot))
+		{
+			Timer_wheelInsert(wT);
+		}
+	}
+
+	uint8_t slot = now & WaitTimer_wheelSlotMask;
+	for (wT = Timer_wheelPop(slot); wT != 0; wT = Timer_wheelPop(slot))
+	{
+		if (wT->status & WaitTimer_isActive)
+		{
+			if (wT->currentWaitTime == now)
+			{
+				wT->currentWaitTime = 0;
+				stopTimer(wT, 0);
+			}
+			else
+			{
+				Timer_wheelInsert(wT);
+			}
+		}
+	}
 
+	TRACE(TRACE_TIMER_END, 0);
+	waitSchedulerExited();
+}
+#else
 void waitScheduler()
 {
 	waitSchedulerEntered();
+	TRACE(TRACE_TIMER_BEGIN, 0);
 
 	signed char i;
 	WaitTimer* wT;
@@ -120,12 +623,14 @@ void waitScheduler()
 			}
 			else
 			{
-			    stopTimer(wT);
+			    stopTimer(wT, 0);
 			}
 		}
 	}
 
+	TRACE(TRACE_TIMER_END, 0);
 	waitSchedulerExited();
 }
+#endif /* WAITTIMER_TICKLESS */
 
 #endif /* MAXTIMERS */
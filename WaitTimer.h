@@ -20,6 +20,26 @@
  *      added flag WAITTIMER_TASK to identify that the waitScheduler is called from the task
  *      scheduler. if WAITTIMER_TASK is not defined, the waitScheduler is run directly in
  *      the timer ISR
+ * 2026 10 18
+ *      added flag WAITTIMER_TICKLESS: the timer interrupt is only requested for the next
+ *      expiry, waitScheduler() advances all timers by the elapsed ticks at once
+ *      added flag WAITTIMER_WHEEL: active timers are sorted into a two level timing wheel,
+ *      waitScheduler() only touches the timers that expire on the current tick
+ *      changed cyclic timers: restarted one period after the expiry tick instead of
+ *      one tick later, the cycle time now matches the wait time
+ *      changed function Timer_ISR(): counts rsos_tickCount
+ *      added flags WAITTIMER_WIDE16 and WAITTIMER_WIDE32: the wait time is stored exactly
+ *      in a separate field of type waittime_t instead of 12 Bit plus exponent
+ *      added flag WAITTIMER_CALLBACK: a function called directly by the waitScheduler
+ *      when the timer expires, added function setCallbackOnStop()
+ *      added flag WAITTIMER_SLACK: the expiry of a timer may be delayed up to a given slack,
+ *      so timers expire together, added function initWaitTimer_slack()
+ *      added flag WAITTIMER_SUBSCRIBERS: more than one task can be scheduled when the
+ *      timer expires, added function addSubscriberOnStop() (up to WAITTIMER_MAXSUBSCRIBERS tasks)
+ *      added periodic tasks (MAXPERIODICTASKS): a task released every period without a
+ *      WaitTimer, added functions initPeriodicTask(), PeriodicTask_start(), PeriodicTask_stop()
+ *      waitScheduler() records trace events (if MAXTRACEEVENTS is defined)
+ *      Timer_ISR() checks the budget of the running task (TASK_BUDGET)
  */
 
 #ifndef WAITTIMER_H_
@@ -34,6 +54,29 @@
 
 #ifdef MAXTIMERS
 
+#ifdef WAITTIMER_WIDE32
+#ifdef WAITTIMER_WIDE16
+#error "More than one wait time layout for WaitTimer set"
+#endif /* WAITTIMER_WIDE16 */
+/**
+ * type of wait times: 32 Bit, exact
+ */
+typedef uint32_t waittime_t;
+#define WAITTIMER_WIDE
+#elif defined WAITTIMER_WIDE16
+/**
+ * type of wait times: 16 Bit, exact
+ */
+typedef uint16_t waittime_t;
+#define WAITTIMER_WIDE
+#else
+/**
+ * type of wait times: 16 Bit, stored as 12 Bit plus exponent
+ * (values above 4095 are rounded down to a multiple of 4 or 16)
+ */
+typedef uint16_t waittime_t;
+#endif /* WAITTIMER_WIDE32 */
+
 /**
  * mask for the actual wait time
  */
@@ -69,6 +112,57 @@
  */
 #define WaitTimer_isActive 0x8000
 
+#ifdef WAITTIMER_WHEEL
+#ifdef WAITTIMER_TICKLESS
+#error "WAITTIMER_WHEEL and WAITTIMER_TICKLESS can not be combined"
+#endif /* WAITTIMER_TICKLESS */
+/*
+ * timing wheel operation: the wheel has two levels with
+ * WAITTIMER_WHEELSIZE slots each. level 0 holds the timers that expire within
+ * the next WAITTIMER_WHEELSIZE ticks, one slot per tick. level 1 holds the
+ * later timers, one slot per WAITTIMER_WHEELSIZE ticks; they are moved to
+ * level 0 when their slot is reached.
+ * the wheel is changed from interrupts (setTimer()) and from the waitScheduler,
+ * the HardwareAdaptionLayer must provide enterCritical() / exitCritical()
+ */
+#include <HardwareAdaptionLayer.h>
+
+#ifndef WAITTIMER_WHEELBITS
+/**
+ * number of bits of a wheel slot index, the wheel has (1 << WAITTIMER_WHEELBITS) slots per level
+ */
+#define WAITTIMER_WHEELBITS 4
+#endif /* WAITTIMER_WHEELBITS */
+
+/**
+ * number of slots per level
+ */
+#define WAITTIMER_WHEELSIZE (1 << WAITTIMER_WHEELBITS)
+
+/**
+ * mask for the slot index within one level
+ */
+#define WaitTimer_wheelSlotMask (WAITTIMER_WHEELSIZE - 1)
+
+/**
+ * slot identifier: the slot is on level 1
+ */
+#define WaitTimer_wheelLevel1 WAITTIMER_WHEELSIZE
+
+/**
+ * slot identifier: the timer is not in the wheel
+ */
+#define WaitTimer_noSlot 0xFF
+#endif /* WAITTIMER_WHEEL */
+
+#ifdef WAITTIMER_CALLBACK
+/**
+ * type definition of the function called when a WaitTimer expires
+ * the argument is the pointer given to setCallbackOnStop()
+ */
+typedef void (WaitTimerCallback) (void*);
+#endif /* WAITTIMER_CALLBACK */
+
 struct WaitTimer_t;
 
 /**
@@ -86,28 +180,228 @@ struct WaitTimer_t;
  *              10: shift by 4
  *              11: reserved
  *      W...: wait time (0..4095)
+ *      with WAITTIMER_WIDE16 or WAITTIMER_WIDE32, only A and C are used
+ *  waitTime: (WAITTIMER_WIDE16 / WAITTIMER_WIDE32 only) the exact wait time
  *  taskOnStart: a task that is scheduled when its WaitTimer is set active
  *  taskOnStop: a task that is scheduled when its WaitTimer is stopped
  *  connectedButton: a button connected to this timer, to debounce button
+ *  (WAITTIMER_SLACK only:)
+ *  slackMask: the expiry tick is rounded up to a multiple of (slackMask + 1)
+ *  (WAITTIMER_SUBSCRIBERS only:)
+ *  subscribers: pointer to an external array of tasks scheduled when the timer expires
+ *  numberOfSubscribers: the number of tasks in subscribers
+ *  (WAITTIMER_CALLBACK only:)
+ *  callbackOnStop: a function called when the timer expires, 0 if none
+ *  callbackArgument: the argument passed to callbackOnStop
+ *  (WAITTIMER_WHEEL only:)
+ *  nextInSlot: the next timer number in the same wheel slot, -1 at the end
+ *  slot: the wheel slot the timer is in, WaitTimer_noSlot if not in the wheel
+ *  while the timer is active, currentWaitTime holds the tick it expires on
  *
  * MEMORY:
  *  this structure takes up 6 Bytes
+ *  (8 Bytes with WAITTIMER_WIDE16, 12 Bytes with WAITTIMER_WIDE32,
+ *  2 Bytes more with WAITTIMER_WHEEL, 1 Byte more with WAITTIMER_SLACK,
+ *  2 pointers more with WAITTIMER_CALLBACK, 1 pointer and 1 Byte more with
+ *  WAITTIMER_SUBSCRIBERS)
  *
  */
+#ifdef WAITTIMER_SUBSCRIBERS
+#ifndef WAITTIMER_MAXSUBSCRIBERS
+/**
+ * maximum number of tasks added to one WaitTimer with addSubscriberOnStop()
+ */
+#define WAITTIMER_MAXSUBSCRIBERS 8
+#endif /* WAITTIMER_MAXSUBSCRIBERS */
+#endif /* WAITTIMER_SUBSCRIBERS */
+
 typedef struct WaitTimer_t{
 	volatile uint16_t status;
-	volatile uint16_t currentWaitTime;
+	volatile waittime_t currentWaitTime;
+#ifdef WAITTIMER_WIDE
+	waittime_t waitTime;
+#endif /* WAITTIMER_WIDE */
 	int8_t taskOnStart;
 	int8_t taskOnStop;
+#ifdef WAITTIMER_SLACK
+	uint8_t slackMask;
+#endif /* WAITTIMER_SLACK */
+#ifdef WAITTIMER_SUBSCRIBERS
+	Task* *subscribers;
+	uint8_t numberOfSubscribers;
+#endif /* WAITTIMER_SUBSCRIBERS */
+#ifdef WAITTIMER_CALLBACK
+	WaitTimerCallback* callbackOnStop;
+	void* callbackArgument;
+#endif /* WAITTIMER_CALLBACK */
+#ifdef WAITTIMER_WHEEL
+	volatile int8_t nextInSlot;
+	volatile uint8_t slot;
+#endif /* WAITTIMER_WHEEL */
 } WaitTimer;
 
 extern int8_t timers_size;
 extern WaitTimer waitTimers_mem[MAXTIMERS];
 
+#ifdef WAITTIMER_WHEEL
+/**
+ * the number of ticks processed by the waitScheduler
+ */
+extern volatile waittime_t waitTimer_wheelTime;
+
+/**
+ * first timer number of each wheel slot (level 0 followed by level 1), -1 if empty
+ */
+extern volatile int8_t waitTimer_wheel[2 * WAITTIMER_WHEELSIZE];
+
+/**
+ * removes an active timer from the wheel, the remaining wait time is kept
+ * in currentWaitTime. use haltTimer() instead
+ * @param waitTimer: the timer to remove
+ */
+__EXTERN_C
+void Timer_wheelHalt(WaitTimer* waitTimer);
+
+/**
+ * puts a halted timer back into the wheel. use continueTimer() instead
+ * @param waitTimer: the timer to continue
+ */
+__EXTERN_C
+void Timer_wheelContinue(WaitTimer* waitTimer);
+#endif /* WAITTIMER_WHEEL */
+
 #ifdef WAITTIMER_TASK
 extern Task* task_waitScheduler;
 #endif /* WAITTIMER_TASK */
 
+#ifdef MAXPERIODICTASKS
+/*
+ * periodic tasks: a task is scheduled every period ticks, the first time phase ticks
+ * after it is started. replaces a cyclic WaitTimer with a task on stop.
+ * the release ticks are absolute (lower 16 Bit of rsos_tickCount), so the period does
+ * not drift. the earliest release of all periodic tasks is kept in periodicTask_nextDue,
+ * on a tick without release only this one value is compared.
+ * periods and phases must be below 0x8000 ticks.
+ *
+ * to operate, the following structures must be available per periodic task:
+ *      1x Task (the task to release)
+ * the HardwareAdaptionLayer must provide enterCritical() / exitCritical()
+ */
+#include <HardwareAdaptionLayer.h>
+
+/**
+ * bit identifier: the periodic task is started
+ */
+#define PeriodicTask_isActive 0x01
+
+/**
+ * Periodic task structure
+ * Fields:
+ *  period: the number of ticks between two releases
+ *  nextRelease: the tick of the next release
+ *  task: the number of the task to schedule
+ *  status: bit field:
+ *      xxxx xxxA
+ *      A: is active
+ *
+ * MEMORY:
+ *  this structure takes up 6 Bytes
+ */
+typedef struct PeriodicTask_t {
+    uint16_t period;
+    volatile uint16_t nextRelease;
+    int8_t task;
+    volatile uint8_t status;
+} PeriodicTask;
+
+extern PeriodicTask periodicTask_mem[MAXPERIODICTASKS];
+extern int8_t periodicTask_size;
+
+/**
+ * the earliest release tick of all started periodic tasks
+ */
+extern volatile uint16_t periodicTask_nextDue;
+
+/**
+ * initializes a periodic task, it is stopped
+ * @param task: the task to schedule
+ * @param period: the number of ticks between two releases (1 to 0x7FFF)
+ * @return a reference to the new periodic task
+ */
+__EXTERN_C
+PeriodicTask* initPeriodicTask(Task* task, uint16_t period);
+
+/**
+ * starts a periodic task, nothing is done if it is started already.
+ * may be called in an interrupt routine
+ * @param periodicTask: the periodic task
+ * @param phase: the number of ticks until the first release (at least 1)
+ */
+__EXTERN_C
+void PeriodicTask_start(PeriodicTask* periodicTask, uint16_t phase);
+
+/**
+ * stops a periodic task, the task is not scheduled any more
+ * @param periodicTask: the periodic task
+ */
+__EXTERN_C
+void PeriodicTask_stop(PeriodicTask* periodicTask);
+
+/**
+ * schedules the tasks whose release tick has come, calculates their next release
+ * and periodicTask_nextDue. called by PeriodicTask_tick()
+ */
+__EXTERN_C
+void PeriodicTask_release();
+
+/**
+ * checks for due periodic tasks, called on every tick
+ * (by Timer_ISR(), in tickless operation by the waitScheduler)
+ */
+static inline void PeriodicTask_tick() __attribute__((always_inline));
+static inline void PeriodicTask_tick()
+{
+    if ((int16_t)((uint16_t)rsos_tickCount - periodicTask_nextDue) >= 0)
+    {
+        PeriodicTask_release();
+    }
+}
+
+/**
+ * @param periodicTask: the periodic task
+ * @return true if the periodic task is started
+ */
+static inline RSOS_bool PeriodicTask_isStarted(PeriodicTask* periodicTask) __attribute__((always_inline));
+static inline RSOS_bool PeriodicTask_isStarted(PeriodicTask* periodicTask)
+{
+    return (periodicTask->status & PeriodicTask_isActive) ? RSOS_bool_true : RSOS_bool_false;
+}
+#endif /* MAXPERIODICTASKS */
+
+#ifdef WAITTIMER_TICKLESS
+/*
+ * tickless operation: the timer interrupt does not fire on every tick,
+ * but only when the next WaitTimer expires or a delayed task needs a cycle.
+ * the HardwareAdaptionLayer must provide:
+ *  uint16_t getTickCount(): a free running counter, incremented every tick
+ *  void setTickWakeup(uint16_t tick): request the timer interrupt when getTickCount() reaches tick
+ * the timer interrupt calls Timer_ISR() as in regular operation.
+ */
+
+/**
+ * the tick count the currentWaitTime of all timers refers to
+ */
+extern uint16_t waitTimer_lastTick;
+
+/**
+ * calculates the nearest expiry of all active WaitTimers and delayed tasks
+ * and requests the timer interrupt for this tick (the next tick if DeferredWork is pending).
+ * called by the scheduler before it goes to sleep
+ */
+__EXTERN_C
+void Timer_setNextWakeup();
+#endif /* WAITTIMER_TICKLESS */
+
 /**
  * initialize the wait timer operation.
  * Inits a task with priority 0 that schedules the
@@ -129,6 +423,8 @@ void Timer_initOperation();
 /**
  * the waitTimer waitScheduler.
  * checks all active WaitTimer, decrements their waitTime, runs the tasks if they stop
+ * if WAITTIMER_TICKLESS is defined, the waitTime is decremented by all ticks
+ * passed since the last call
  */
 __EXTERN_C
 void waitScheduler();
@@ -136,10 +432,22 @@ void waitScheduler();
 /**
  * to be called in a timer interrupt routine.
  * The task task_waitScheduler is scheduled.
+ * Also counts the tick counter returned by RSOS_now(), releases the periodic tasks
+ * and checks the budget of the running task (TASK_BUDGET, in tickless operation
+ * only on the requested wakeups)
  */
 static inline void Timer_ISR() __attribute__((always_inline));
 static inline void Timer_ISR()
 {
+#ifdef TASK_BUDGET
+    Task_checkBudget();
+#endif /* TASK_BUDGET */
+#ifndef WAITTIMER_TICKLESS
+    rsos_tickCount += 1;
+#ifdef MAXPERIODICTASKS
+    PeriodicTask_tick();
+#endif /* MAXPERIODICTASKS */
+#endif /* WAITTIMER_TICKLESS */
 #ifdef WAITTIMER_TASK
     scheduleTask(task_waitScheduler);
 #else
@@ -149,11 +457,36 @@ static inline void Timer_ISR()
 
 /**
  * initializes a wait timer. Timer can schedule a Task on starting and on stop
- * @param waitTime: the time to wait; 0..250 Ticks (250 Ticks = 5 sec)
+ * @param waitTime: the time to wait in Ticks, exact up to 4095 Ticks in the packed layout,
+ *        exact in the full range of waittime_t with WAITTIMER_WIDE16 / WAITTIMER_WIDE32
  * @return a reference to the new WaitTimer
  */
 __EXTERN_C
-WaitTimer* initWaitTimer(uint16_t waitTime);
+WaitTimer* initWaitTimer(waittime_t waitTime);
+
+#ifdef WAITTIMER_SLACK
+/**
+ * initializes a wait timer that may expire later than its wait time.
+ * The expiry tick is rounded up to a multiple of the largest power of two
+ * not bigger than slack + 1, so timers with a similar slack expire on the same tick
+ * and the scheduler is woken less often. For timers with soft deadlines like debouncing.
+ * A cyclic timer keeps its cycle time if the wait time is a multiple of this power of two
+ * @param waitTime: the time to wait in Ticks, see initWaitTimer()
+ * @param slack: the maximum number of Ticks the expiry may be delayed (0..255)
+ * @return a reference to the new WaitTimer
+ */
+__EXTERN_C
+WaitTimer* initWaitTimer_slack(waittime_t waitTime, uint8_t slack);
+
+/**
+ * sets the slack of a wait timer, see initWaitTimer_slack()
+ * takes effect the next time the timer is started
+ * @param waitTimer: the timer
+ * @param slack: the maximum number of Ticks the expiry may be delayed (0..255)
+ */
+__EXTERN_C
+void setTimerSlack(WaitTimer* waitTimer, uint8_t slack);
+#endif /* WAITTIMER_SLACK */
 
 /**
  * add a task that should be scheduled if the waitTimer is started
@@ -173,6 +506,40 @@ void setTaskOnStart(WaitTimer* waitTimer, Task* task);
 __EXTERN_C
 void setTaskOnStop(WaitTimer* waitTimer, Task* task);
 
+#ifdef WAITTIMER_SUBSCRIBERS
+/**
+ * add another task that should be scheduled if the WaitTimer is stopped,
+ * in addition to the task set by setTaskOnStop(). Several periodic tasks can
+ * share one timer this way. it is possible to add up to WAITTIMER_MAXSUBSCRIBERS tasks
+ * @param waitTimer: the WaitTimer to add the task to
+ * @param subscriberArray: a pointer to an initialized Array where the tasks are stored.
+ *        might be null, but only if a valid array was added prior. The Array must contain enough space
+ *        for the number of tasks to be added, at most WAITTIMER_MAXSUBSCRIBERS. Calling the function
+ *        with a different pointer than the prior pointer has no effect.
+ * @param task: the task to add
+ * @return RSOS_ret_ERROR if WAITTIMER_MAXSUBSCRIBERS tasks are already added
+ *         or no array was given, else RSOS_ret_OK
+ */
+__EXTERN_C
+RSOS_ret addSubscriberOnStop(WaitTimer* waitTimer, Task* *subscriberArray, Task* task);
+#endif /* WAITTIMER_SUBSCRIBERS */
+
+#ifdef WAITTIMER_CALLBACK
+/**
+ * add a function that is called when the WaitTimer expires.
+ * the function is called by the waitScheduler, i.e. in the timer interrupt if
+ * WAITTIMER_TASK is not defined (keep it short!), else in the waitScheduler task.
+ * it is called after the timer is stopped (or restarted, if cyclic), so the function
+ * may call setTimer() or haltTimer() for the timer.
+ * the task on stop is scheduled as well.
+ * @param waitTimer: the WaitTimer to add the function to
+ * @param callback: the function to call, 0 to remove the function
+ * @param argument: the argument passed to the function
+ */
+__EXTERN_C
+void setCallbackOnStop(WaitTimer* waitTimer, WaitTimerCallback* callback, void* argument);
+#endif /* WAITTIMER_CALLBACK */
+
 /**
  * sets a new wait time to the timer. this only affects the current wait time, after the timer is stopped, the original time is restored
  * can be used in combination with haltTimer and continueTimer
@@ -180,10 +547,12 @@ void setTaskOnStop(WaitTimer* waitTimer, Task* task);
  * @param waitTime: the new wait time
  */
 __EXTERN_C
-void setNewWaitTime(uint16_t waitTime, WaitTimer* waitTimer);
+void setNewWaitTime(waittime_t waitTime, WaitTimer* waitTimer);
 
 /**
  * sets the specified timer to be started again after it reaches zero
+ * the timer expires every waitTime ticks (at least every tick), the next expiry is
+ * calculated from the last expiry tick, so the cycle does not drift
  * @param waitTimer: the timer to set cyclic
  */
 __EXTERN_C
@@ -215,7 +584,11 @@ void setTimer(WaitTimer* waitTimer);
 static inline void haltTimer(WaitTimer* waitTimer) __attribute__((always_inline));
 static inline void haltTimer(WaitTimer* waitTimer)
 {
+#ifdef WAITTIMER_WHEEL
+    Timer_wheelHalt(waitTimer);
+#else
     waitTimer->status &= ~WaitTimer_isActive;
+#endif /* WAITTIMER_WHEEL */
 }
 
 /**
@@ -226,7 +599,11 @@ static inline void haltTimer(WaitTimer* waitTimer)
 static inline void continueTimer(WaitTimer* waitTimer) __attribute__((always_inline));
 static inline void continueTimer(WaitTimer* waitTimer)
 {
+#ifdef WAITTIMER_WHEEL
+    Timer_wheelContinue(waitTimer);
+#else
     waitTimer->status |= WaitTimer_isActive;
+#endif /* WAITTIMER_WHEEL */
 }
 
 #endif /* MAXTIMERS */
@@ -0,0 +1,112 @@
+/*
+ * MessageQueue.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include "MessageQueue.h"
+
+/* exclude everything if not used */
+#ifdef MAXMESSAGEQUEUES
+
+#include <HardwareAdaptionLayer.h>
+
+MessageQueue messageQueue_mem[MAXMESSAGEQUEUES];
+int8_t messageQueue_size = 0;
+
+Task* task_messageQueueCheck = 0;
+
+/**
+ * the follow-up arrays of the consumers, one entry per queue
+ */
+static Task* messageQueue_followUp[MAXMESSAGEQUEUES];
+
+/**
+ * the task function, follow-up task of the consumers: a message committed
+ * while its consumer ran did not schedule it, the consumer is scheduled again
+ */
+static void MessageQueue_check()
+{
+    int8_t i;
+    for (i=0; i<messageQueue_size; i++)
+    {
+        if (messageQueue_mem[i].count != 0 && messageQueue_mem[i].task != -1)
+        {
+            scheduleTask(&task_mem[messageQueue_mem[i].task]);
+        }
+    }
+}
+
+/**
+ * @return RSOS_bool_true if the check task is a follow-up task of the consumer
+ */
+static RSOS_bool MessageQueue_isChecked(Task* consumer)
+{
+    int8_t i = (consumer->status & followUpNumberMask) >> 12;
+    for (; i>0; i--)
+    {
+        if (consumer->followUpTask[i-1] == task_messageQueueCheck)
+        {
+            return RSOS_bool_true;
+        }
+    }
+    return RSOS_bool_false;
+}
+
+void initMessageQueueOperation()
+{
+    task_messageQueueCheck = addTask(MESSAGEQUEUE_PRIORITY, MessageQueue_check);
+}
+
+MessageQueue* initMessageQueue(void* data, uint8_t numberOfMessages, uint8_t messageSize, Task* consumer)
+{
+    if (consumer != 0 && !MessageQueue_isChecked(consumer))
+    {
+        addFollowUpTask(consumer, &messageQueue_followUp[messageQueue_size], task_messageQueueCheck);
+    }
+    messageQueue_mem[messageQueue_size].buffer = BasicBuffer_getNumber(initBuffer(data, numberOfMessages, BUFFER_TYPE_RING));
+    messageQueue_mem[messageQueue_size].messageSize = messageSize;
+    messageQueue_mem[messageQueue_size].count = 0;
+    messageQueue_mem[messageQueue_size].task = (consumer != 0) ? getTaskNumber(consumer) : -1;
+    messageQueue_mem[messageQueue_size].reserved = RSOS_bool_false;
+
+    messageQueue_size += 1;
+    return &messageQueue_mem[messageQueue_size - 1];
+}
+
+RSOS_ret MessageQueue_commit(MessageQueue* queue)
+{
+    // reserve() only reserves a message if the queue is not full
+    if (!queue->reserved)
+    {
+        return RSOS_ret_ERROR;
+    }
+    queue->reserved = RSOS_bool_false;
+    Buffer_uint8_increment_index_put(getBuffer_uint8(queue->buffer));
+
+    uint16_t interruptState = enterCritical();
+    queue->count += 1;
+    exitCritical(interruptState);
+
+    if (queue->task != -1)
+    {
+        scheduleTask(&task_mem[queue->task]);
+    }
+    return RSOS_ret_OK;
+}
+
+void MessageQueue_release(MessageQueue* queue)
+{
+    if (queue->count == 0)
+    {
+        return;
+    }
+    Buffer_uint8_increment_index_pop(getBuffer_uint8(queue->buffer));
+
+    uint16_t interruptState = enterCritical();
+    queue->count -= 1;
+    exitCritical(interruptState);
+}
+
+#endif /* MAXMESSAGEQUEUES */
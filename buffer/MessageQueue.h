@@ -0,0 +1,172 @@
+/*
+ * MessageQueue.h
+ *
+ * a queue of fixed size messages between tasks (or from an interrupt to a task)
+ *
+ * the queue is a ring buffer of BasicBuffer, the buffer index counts messages.
+ * messages are not copied: the producer writes the message into the queue
+ * and the consumer reads it from the queue.
+ *
+ * operation:
+ *      1.  initMessageQueueOperation() adds the task that checks the queues
+ *      2.  producer: MessageQueue_reserve() returns the memory of the next free message,
+ *          the producer writes to it and calls MessageQueue_commit()
+ *      3.  the commit schedules the consumer task
+ *      4.  consumer: MessageQueue_peek() returns the oldest message,
+ *          after reading it the consumer calls MessageQueue_release()
+ *
+ * one producer and one consumer per queue. The consumer task should take all
+ * messages in one run. A commit while the consumer runs can not schedule it again,
+ * so the check task is added as a follow-up task of the consumer: when the consumer
+ * is unscheduled, the check task schedules it again if its queue is not empty.
+ * follow-up tasks of the consumer must be added before initMessageQueue(),
+ * with an array of one more task.
+ *
+ * to operate, the following structures must be available:
+ *      1x Task (the check task)
+ *      1x Buffer_void per queue
+ * the HardwareAdaptionLayer must provide enterCritical() / exitCritical()
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef BUFFER_MESSAGEQUEUE_H_
+#define BUFFER_MESSAGEQUEUE_H_
+
+#include <RSOSDefines.h>
+
+/* exclude everything if not used */
+#ifdef MAXMESSAGEQUEUES
+
+#ifndef MAXBUFFER_VOID
+#error "MessageQueue needs MAXBUFFER_VOID"
+#endif /* MAXBUFFER_VOID */
+
+#include <stdint.h>
+
+#include "../Task.h"
+#include "Buffer_int8.h"
+
+#ifndef MESSAGEQUEUE_PRIORITY
+/**
+ * priority of the task that checks the queues after a consumer ran
+ */
+#define MESSAGEQUEUE_PRIORITY priorityMask
+#endif /* MESSAGEQUEUE_PRIORITY */
+
+/**
+ * Message queue structure
+ * Fields:
+ *  buffer: the number of the ring buffer holding the messages
+ *  messageSize: the size of one message in bytes
+ *  count: the number of committed messages not yet released
+ *  task: the number of the consumer task, -1 if no task is scheduled
+ *  reserved: 1 if a message is reserved and not yet committed
+ *
+ * MEMORY:
+ *  this structure takes up 5 Bytes
+ */
+typedef struct MessageQueue_t {
+    int8_t buffer;
+    uint8_t messageSize;
+    volatile uint8_t count;
+    int8_t task;
+    RSOS_bool reserved;
+} MessageQueue;
+
+extern MessageQueue messageQueue_mem[MAXMESSAGEQUEUES];
+extern int8_t messageQueue_size;
+
+/**
+ * the task that schedules the consumers of the queues that are not empty,
+ * follow-up task of every consumer
+ */
+extern Task* task_messageQueueCheck;
+
+/**
+ * initializes the message queue operation, adds the check task
+ */
+__EXTERN_C
+void initMessageQueueOperation();
+
+/**
+ * initializes a new message queue
+ * @param data: the memory for the messages, at least numberOfMessages * messageSize bytes
+ * @param numberOfMessages: the number of messages the queue holds
+ * @param messageSize: the size of one message in bytes
+ * @param consumer: the task to schedule when a message is committed, 0 for none.
+ *        the check task is added as its follow-up task
+ * @return a reference to the new queue
+ */
+__EXTERN_C
+MessageQueue* initMessageQueue(void* data, uint8_t numberOfMessages, uint8_t messageSize, Task* consumer);
+
+/**
+ * commits the reserved message, the consumer task is scheduled
+ * @param queue: the queue
+ * @return RSOS_ret_ERROR if no message is reserved (MessageQueue_reserve() was not called
+ *         or returned 0), nothing is committed then. else RSOS_ret_OK
+ */
+__EXTERN_C
+RSOS_ret MessageQueue_commit(MessageQueue* queue);
+
+/**
+ * releases the oldest message, its memory is free for the producer
+ * @param queue: the queue
+ */
+__EXTERN_C
+void MessageQueue_release(MessageQueue* queue);
+
+/**
+ * @return the message at a slot of the buffer
+ */
+static inline void* MessageQueue_slot(MessageQueue* queue, uint8_t slot) __attribute__((always_inline));
+static inline void* MessageQueue_slot(MessageQueue* queue, uint8_t slot)
+{
+    return getBuffer_uint8(queue->buffer)->buffer + (uint16_t)slot * queue->messageSize;
+}
+
+/**
+ * reserves the next free message. Calling it again before the commit
+ * returns the same message.
+ * @param queue: the queue
+ * @return the memory of the message to write to, 0 if the queue is full
+ */
+static inline void* MessageQueue_reserve(MessageQueue* queue) __attribute__((always_inline));
+static inline void* MessageQueue_reserve(MessageQueue* queue)
+{
+    if (queue->count >= getBuffer_uint8(queue->buffer)->data.size)
+    {
+        return 0;
+    }
+    queue->reserved = RSOS_bool_true;
+    return MessageQueue_slot(queue, getBuffer_uint8(queue->buffer)->index.index_put);
+}
+
+/**
+ * @param queue: the queue
+ * @return the oldest message, 0 if the queue is empty
+ */
+static inline void* MessageQueue_peek(MessageQueue* queue) __attribute__((always_inline));
+static inline void* MessageQueue_peek(MessageQueue* queue)
+{
+    if (queue->count == 0)
+    {
+        return 0;
+    }
+    return MessageQueue_slot(queue, getBuffer_uint8(queue->buffer)->index.index_pop);
+}
+
+/**
+ * @param queue: the queue
+ * @return the number of messages in the queue
+ */
+static inline uint8_t MessageQueue_getCount(MessageQueue* queue) __attribute__((always_inline));
+static inline uint8_t MessageQueue_getCount(MessageQueue* queue)
+{
+    return queue->count;
+}
+
+#endif /* MAXMESSAGEQUEUES */
+#endif /* BUFFER_MESSAGEQUEUE_H_ */
@@ -17,7 +17,11 @@ RSOSDivision rsosDivision_uint16_mem[MAXRSOSDIVISION];
 int8_t rsosDivision_size;
 
 
-void divideOperation()
+/**
+ * does one step of every active division
+ * @return RSOS_bool_true if a division is active
+ */
+static RSOS_bool divideStep()
 {
     int8_t i = rsosDivision_size;
     RSOS_bool noDivisionOperation = RSOS_bool_true;
@@ -47,21 +51,39 @@ void divideOperation()
     		}
     	}
     }
+    return !noDivisionOperation;
+}
 
-    if (noDivisionOperation)
+#ifdef TASK_RESUMABLE
+void divideOperation()
+{
+    TASK_BEGIN();
+    while (divideStep())
     {
-        task_mem[currentRunningTask].currentCycle = 0;
+        TASK_YIELD();
     }
-    else
+    TASK_END();
+}
+#else
+void divideOperation()
+{
+    if (divideStep())
     {
         task_mem[currentRunningTask].currentCycle = 2;
     }
+    else
+    {
+        task_mem[currentRunningTask].currentCycle = 0;
+    }
 }
+#endif /* TASK_RESUMABLE */
 
 void RSOSDivision_initOperation(uint8_t taskPriority)
 {
     task_divide = addTask(taskPriority, divideOperation);
+#ifndef TASK_RESUMABLE
     setTaskCyclic(task_divide, 2);
+#endif /* TASK_RESUMABLE */
 }
 
 RSOSDivision* RSOSDivision_init()
@@ -10,15 +10,23 @@
 /* exclude everything if not used */
 #ifdef MAXBUTTONS
 
+#ifdef MAXPERIODICTASKS
+PeriodicTask* periodicTask_buttonWaitScheduler = 0;
+#else
 WaitTimer* timer_buttonWaitScheduler = 0;
+#endif /* MAXPERIODICTASKS */
 
 void initButtonOperation(uint16_t clockMultiply) {
 	Task* task_buttonWaitScheduler = addTask(0, buttonWaitScheduler);
+#ifdef MAXPERIODICTASKS
+    periodicTask_buttonWaitScheduler = initPeriodicTask(task_buttonWaitScheduler, clockMultiply);
+#else
     timer_buttonWaitScheduler = initWaitTimer(clockMultiply);
 
     setTimerCyclic(timer_buttonWaitScheduler);
     setTaskOnStop(timer_buttonWaitScheduler, task_buttonWaitScheduler);
 //    setTimer(timer_buttonWaitScheduler);
+#endif /* MAXPERIODICTASKS */
 }
 
 static inline uint8_t Button_getExponentAndTime(uint8_t time) __attribute__((always_inline));;
@@ -93,13 +101,18 @@ static inline void buttonReleased(Button* button) __attribute__((always_inline))
 static inline void buttonReleased(Button* button) {
     enableBtnInterrupt(button);
     if ((~button->status & Button_taskOnPress) && button->task != -1) {
+#ifdef TASK_ARGUMENT
+        scheduleTaskWithArg(&task_mem[button->task], button);
+#else
         scheduleTask(&task_mem[button->task]);
+#endif /* TASK_ARGUMENT */
     }
     button->status &= ~Button_isActive;
 }
 
 void buttonWaitScheduler() {
     buttonSchedulerEntered();
+    TRACE(TRACE_BUTTONS_BEGIN, 0);
 
     int8_t i;
     uint8_t noButtons = 0;
@@ -134,9 +147,14 @@ void buttonWaitScheduler() {
 
     if (noButtons >= buttons_size)
     {
+#ifdef MAXPERIODICTASKS
+    	PeriodicTask_stop(periodicTask_buttonWaitScheduler);	// end operation
+#else
     	haltTimer(timer_buttonWaitScheduler);	// end operation
+#endif /* MAXPERIODICTASKS */
     }
 
+    TRACE(TRACE_BUTTONS_END, 0);
     buttonSchedulerExited();
 }
 
@@ -20,6 +20,10 @@
  * 		interrupt enabled etc)
  * 		changed function disableBtnInterrupt() and enableBtnInterrupt(): now call setPortInterrupt() in the
  * 		hardware adaption layer
+ * 2026 10 18
+ *      with TASK_ARGUMENT, the task of a button is scheduled with the button as argument
+ *      with MAXPERIODICTASKS, the buttonWaitScheduler is released by a periodic task instead of a WaitTimer
+ *      buttonWaitScheduler() records trace events (if MAXTRACEEVENTS is defined)
  */
 
 #ifndef BUTTONS_H_
@@ -37,7 +41,11 @@
 #include "../WaitTimer.h"
 #include <HardwareAdaptionLayer.h>
 
+#ifdef MAXPERIODICTASKS
+extern PeriodicTask* periodicTask_buttonWaitScheduler;
+#else
 extern WaitTimer* timer_buttonWaitScheduler;
+#endif /* MAXPERIODICTASKS */
 
 //#include <msp430.h>
 
@@ -115,10 +123,11 @@ extern Button buttons_mem[MAXBUTTONS];
  * enables button operation
  * this function inits the task "task_buttonWaitScheduler"
  * and the connected WaitTimer "timer_buttonWaitScheduler"
+ * (with MAXPERIODICTASKS the periodic task "periodicTask_buttonWaitScheduler")
  *
  * to operate, the following structures must be available:
  *      1x Task
- *      1x WaitTimer
+ *      1x WaitTimer (1x PeriodicTask with MAXPERIODICTASKS)
  *
  * it is possible to add a multiplier to all button debounce times
  * this is done by the wait timer which controls the button wait scheduler
@@ -214,11 +223,19 @@ static inline void buttonPressed(Button* button) {
         disableBtnInterrupt(button);
         Button_setWaitTime(button);
         if ((button->status & Button_taskOnPress) && (button->task != -1)) {
+#ifdef TASK_ARGUMENT
+            scheduleTaskWithArg(&task_mem[button->task], button);
+#else
             scheduleTask(&task_mem[button->task]);
+#endif /* TASK_ARGUMENT */
         }
         button->status |= Button_isActive;
     }
+#ifdef MAXPERIODICTASKS
+    PeriodicTask_start(periodicTask_buttonWaitScheduler, periodicTask_buttonWaitScheduler->period);
+#else
     setTimer(timer_buttonWaitScheduler);
+#endif /* MAXPERIODICTASKS */
 }
 
 /**
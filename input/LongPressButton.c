@@ -11,19 +11,34 @@
 
 static Task* task_enableLPB = 0;
 
+#ifdef TASK_ARGUMENT
+/**
+ * the number of the long press button for each button number,
+ * to find the long press button of the button passed to longPressButton_Enable()
+ */
+static int8_t longPressButton_ofButton[MAXBUTTONS];
+#endif /* TASK_ARGUMENT */
+
 void initLongPressButtonOperation(uint16_t clockMultiply) {
     task_enableLPB = addTask(0, longPressButton_Enable);
 
     Task* task_scheduler = addTask(0, longPressButtonWaitScheduler);
+#ifdef MAXPERIODICTASKS
+    PeriodicTask_start(initPeriodicTask(task_scheduler, clockMultiply), clockMultiply);
+#else
     WaitTimer* timer_scheduler = initWaitTimer(clockMultiply);
     setTaskOnStop(timer_scheduler, task_scheduler);
     setTimerCyclic(timer_scheduler);
     setTimer(timer_scheduler);
+#endif /* MAXPERIODICTASKS */
 }
 
 LongPressButton* initLPButton(uint8_t bit, volatile uint8_t * portRegister, uint8_t waitTime) {
     longPressButton_mem[longPressButton_size].button = initButton(bit, portRegister, waitTime);
     addTaskOnPressToButton(longPressButton_mem[longPressButton_size].button, task_enableLPB);
+#ifdef TASK_ARGUMENT
+    longPressButton_ofButton[longPressButton_mem[longPressButton_size].button - buttons_mem] = longPressButton_size;
+#endif /* TASK_ARGUMENT */
     longPressButton_mem[longPressButton_size].cycle = 0;
     longPressButton_mem[longPressButton_size].longPressTask = -1;
     longPressButton_mem[longPressButton_size].shortPressTask = -1;
@@ -68,20 +83,31 @@ static inline void longPressButton_setWaitTime(LongPressButton* btn) {
     }
 }
 
+static inline void longPressButton_enableButton(LongPressButton* btn) __attribute__((always_inline));
+static inline void longPressButton_enableButton(LongPressButton* btn) {
+    if (btn->button->status & Button_isActive)
+    {
+        if (~btn->status & LongPressButton_isReleased)
+        {
+            btn->status |= LongPressButton_isActive;
+            btn->button->status &= ~Button_isActive;
+            btn->cycle = 0;
+            longPressButton_setWaitTime(btn);
+        }
+    }
+}
+
 void longPressButton_Enable() {
+#ifdef TASK_ARGUMENT
+    Button* button = (Button*) Task_getArgument();
+    if (button != 0) {          // only this button was pressed
+        longPressButton_enableButton(&longPressButton_mem[longPressButton_ofButton[button - buttons_mem]]);
+        return;
+    }
+#endif /* TASK_ARGUMENT */
     int8_t i = longPressButton_size;
     for (; i>0; i-= 1) {
-        LongPressButton* btn = &longPressButton_mem[i-1];
-        if (btn->button->status & Button_isActive)
-        {
-            if (~btn->status & LongPressButton_isReleased)
-            {
-                btn->status |= LongPressButton_isActive;
-                btn->button->status &= ~Button_isActive;
-                btn->cycle = 0;
-                longPressButton_setWaitTime(btn);
-            }
-        }
+        longPressButton_enableButton(&longPressButton_mem[i-1]);
     }
 }
 
@@ -90,7 +116,11 @@ static inline void longPressButton_Disable(LongPressButton* btn) {
     btn->button->status |= Button_isActive;
     btn->status &= ~LongPressButton_isActive;
     btn->status |= LongPressButton_isReleased;
+#ifdef MAXPERIODICTASKS
+    PeriodicTask_start(periodicTask_buttonWaitScheduler, periodicTask_buttonWaitScheduler->period);
+#else
     setTimer(timer_buttonWaitScheduler);
+#endif /* MAXPERIODICTASKS */
 }
 
 void longPressButtonWaitScheduler() {
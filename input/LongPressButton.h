@@ -81,7 +81,7 @@ extern int8_t longPressButton_size;
  *
  * to operate, the following structures must be available:
  *      2x Task
- *      1x WaitTimer
+ *      1x WaitTimer (1x PeriodicTask with MAXPERIODICTASKS)
  *
  * it is possible to add a multiplier to all button debounce times
  * this is done by the wait timer which controls the button wait scheduler
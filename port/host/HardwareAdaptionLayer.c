@@ -0,0 +1,479 @@
+/*
+ * HardwareAdaptionLayer.c
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "HardwareAdaptionLayer.h"
+
+#include <RSOSDefines.h>
+#include <time.h>
+
+#include "../../Task.h"
+
+volatile uint32_t host_virtualTicks = 0;
+uint32_t host_schedulerPasses = 0;
+uint32_t host_schedulerWaits = 0;
+
+volatile unsigned char P1IN = 0xFF, P1OUT = 0, P1DIR = 0, P1IE = 0, P1IES = 0, P1IFG = 0;
+volatile unsigned char P2IN = 0xFF, P2OUT = 0, P2DIR = 0, P2IE = 0, P2IES = 0, P2IFG = 0;
+
+volatile unsigned char host_USCITXBUF = 0;
+volatile unsigned char host_USCIRXBUF = 0;
+volatile uint8_t host_USCIIFG = HOST_USCI_TXIFG;
+
+volatile unsigned char host_I2CTXBUF = 0;
+volatile unsigned char host_I2CRXBUF = 0;
+volatile uint8_t host_I2CIFG = 0;
+
+static HostInterruptHandler* host_handler[HOST_IRQ_NUMBER];
+
+/**
+ * the raised interrupts, not yet served (HOST_IRQ_...)
+ */
+static volatile uint8_t host_pending = 0;
+
+/**
+ * the global interrupt enable
+ */
+static volatile uint8_t host_interruptsEnabled = 1;
+
+/**
+ * 1 while an interrupt service routine runs, interrupts do not nest
+ * (but in schedulerPreempt())
+ */
+static uint8_t host_inInterrupt = 0;
+
+static uint32_t host_tickLimit = 0;
+static uint16_t host_tickWakeup = 0;
+
+static HostSPISlave* host_spiSlave = 0;
+static uint8_t host_USCIIE = 0;
+static uint8_t host_USCIenabled = 0;
+
+static HostI2CSlave* host_i2cSlave = 0;
+static uint8_t host_i2cAddress = 0;
+static uint8_t host_i2cTransmit = 0;
+static uint8_t host_i2cBusy = 0;
+
+/**
+ * raises the USCI interrupt if an enabled flag is set
+ */
+static void host_updateUSCI()
+{
+    if (host_USCIenabled && (host_USCIIFG & host_USCIIE))
+    {
+        host_raiseInterrupt(HOST_IRQ_USCI);
+    }
+}
+
+/**
+ * @return the interrupt enable register of a port
+ */
+static volatile unsigned char * host_getIE(volatile unsigned char * port)
+{
+    return (port == &P1IN) ? &P1IE : &P2IE;
+}
+
+/**
+ * @return the interrupt flag register of a port
+ */
+static volatile unsigned char * host_getIFG(volatile unsigned char * port)
+{
+    return (port == &P1IN) ? &P1IFG : &P2IFG;
+}
+
+static inline void host_callHandler(uint8_t number) __attribute__((always_inline));
+static inline void host_callHandler(uint8_t number)
+{
+    if (host_handler[number] != 0)
+    {
+        host_handler[number]();
+    }
+}
+
+/**
+ * serves the USCI interrupt: the receive flag first, then the transmit flag.
+ * a transmit interrupt that leaves the transmit interrupt enabled has written
+ * a byte, it is shifted out and the received byte is put to the receive buffer
+ */
+static void host_serveUSCI(uint8_t number)
+{
+    uint8_t flags = host_USCIIFG & host_USCIIE;
+
+    if (flags & HOST_USCI_RXIFG)
+    {
+        host_USCIIFG = HOST_USCI_RXIFG;
+        host_callHandler(number);
+        host_USCIIFG = (host_USCIIFG & ~HOST_USCI_RXIFG) | HOST_USCI_TXIFG;
+    }
+    else if (flags & HOST_USCI_TXIFG)
+    {
+        host_USCIIFG = HOST_USCI_TXIFG;
+        host_callHandler(number);
+        if (host_USCIIE & HOST_USCI_TXIFG)
+        {
+            host_USCIRXBUF = (host_spiSlave != 0) ? host_spiSlave(host_USCITXBUF) : host_USCITXBUF;
+            host_USCIIFG |= HOST_USCI_RXIFG;
+        }
+    }
+    host_updateUSCI();
+}
+
+/**
+ * serves the I2C interrupt. A transmit interrupt that does not clear the flag
+ * has written a byte, a receive interrupt is followed by the next byte of the slave
+ * as long as no stop condition is set
+ */
+static void host_serveI2C(uint8_t number)
+{
+    uint8_t flags = host_I2CIFG;
+
+    host_callHandler(number);
+
+    if (!host_i2cBusy)
+    {
+        return;
+    }
+    if ((flags & I2C_IFG_TX) && host_i2cTransmit && (host_I2CIFG & I2C_IFG_TX))
+    {
+        if (host_i2cSlave != 0)
+        {
+            host_i2cSlave(host_i2cAddress, host_I2CTXBUF, 0);
+        }
+        host_raiseInterrupt(HOST_IRQ_I2C);
+    }
+    else if ((flags & I2C_IFG_RX) && !host_i2cTransmit)
+    {
+        host_I2CRXBUF = (host_i2cSlave != 0) ? host_i2cSlave(host_i2cAddress, 0, 1) : 0xFF;
+        host_I2CIFG |= I2C_IFG_RX;
+        host_raiseInterrupt(HOST_IRQ_I2C);
+    }
+}
+
+static void host_serve(uint8_t number)
+{
+    host_inInterrupt = 1;
+    host_interruptsEnabled = 0;
+
+    switch (1 << number)
+    {
+    case HOST_IRQ_USCI: host_serveUSCI(number); break;
+    case HOST_IRQ_I2C: host_serveI2C(number); break;
+    default: host_callHandler(number); break;
+    }
+
+    host_interruptsEnabled = 1;
+    host_inInterrupt = 0;
+}
+
+void host_setInterruptHandler(uint8_t source, HostInterruptHandler* handler)
+{
+    uint8_t i;
+    for (i=0; i<HOST_IRQ_NUMBER; i++)
+    {
+        if (source & (1 << i))
+        {
+            host_handler[i] = handler;
+        }
+    }
+}
+
+void host_raiseInterrupt(uint8_t source)
+{
+    host_pending |= source;
+    host_serveInterrupts();
+}
+
+uint16_t host_serveInterrupts()
+{
+    uint16_t served = 0;
+    uint8_t i;
+
+    if (!host_interruptsEnabled || host_inInterrupt)
+    {
+        return 0;
+    }
+    while (host_pending)
+    {
+        // lowest number first, as the interrupt priority of the vector table
+        for (i=0; i<HOST_IRQ_NUMBER; i++)
+        {
+            if (host_pending & (1 << i))
+            {
+                host_pending &= ~(1 << i);
+                host_serve(i);
+                served += 1;
+                break;
+            }
+        }
+    }
+    return served;
+}
+
+void host_advanceTime(uint32_t ticks)
+{
+    for (; ticks>0; ticks--)
+    {
+        host_virtualTicks += 1;
+#ifdef WAITTIMER_TICKLESS
+        if ((uint16_t)host_virtualTicks == host_tickWakeup)
+#endif /* WAITTIMER_TICKLESS */
+        {
+            host_raiseInterrupt(HOST_IRQ_TIMER);
+        }
+    }
+}
+
+void host_setTickLimit(uint32_t limit)
+{
+    host_tickLimit = limit;
+}
+
+void host_reset()
+{
+    uint8_t i;
+    for (i=0; i<HOST_IRQ_NUMBER; i++)
+    {
+        host_handler[i] = 0;
+    }
+    host_pending = 0;
+    host_interruptsEnabled = 1;
+    host_inInterrupt = 0;
+
+    host_virtualTicks = 0;
+    host_schedulerPasses = 0;
+    host_schedulerWaits = 0;
+    host_tickLimit = 0;
+    host_tickWakeup = 0;
+
+    P1IN = 0xFF; P1OUT = 0; P1DIR = 0; P1IE = 0; P1IES = 0; P1IFG = 0;
+    P2IN = 0xFF; P2OUT = 0; P2DIR = 0; P2IE = 0; P2IES = 0; P2IFG = 0;
+
+    host_spiSlave = 0;
+    host_USCIIE = 0;
+    host_USCIenabled = 0;
+    host_USCIIFG = HOST_USCI_TXIFG;
+
+    host_i2cSlave = 0;
+    host_i2cBusy = 0;
+    host_i2cTransmit = 0;
+    host_I2CIFG = 0;
+}
+
+void schedulerWait()
+{
+    uint32_t ticks = 1;
+
+    host_schedulerWaits += 1;
+
+    // woken up by an interrupt
+    if (host_serveInterrupts() != 0)
+    {
+        return;
+    }
+
+#ifdef WAITTIMER_TICKLESS
+    ticks = (uint16_t)(host_tickWakeup - (uint16_t)host_virtualTicks);
+    if (ticks == 0)
+    {
+        ticks = 0x10000;
+    }
+#endif /* WAITTIMER_TICKLESS */
+
+    if (host_tickLimit != 0 && host_virtualTicks + ticks > host_tickLimit)
+    {
+        disableScheduler();
+        if (host_virtualTicks >= host_tickLimit)
+        {
+            return;
+        }
+        // the tick at the limit is served, it finishes delayed tasks
+        ticks = host_tickLimit - host_virtualTicks;
+    }
+
+    host_virtualTicks += ticks;
+    host_raiseInterrupt(HOST_IRQ_TIMER);
+}
+
+void preemptSchedulerEntered()
+{
+    host_inInterrupt = 0;
+    host_interruptsEnabled = 1;
+    host_serveInterrupts();
+}
+
+void preemptSchedulerExited()
+{
+    host_interruptsEnabled = 0;
+    host_inInterrupt = 1;
+}
+
+uint16_t enterCritical()
+{
+    uint16_t state = host_interruptsEnabled;
+    host_interruptsEnabled = 0;
+    return state;
+}
+
+void exitCritical(uint16_t state)
+{
+    host_interruptsEnabled = state;
+    if (state)
+    {
+        host_serveInterrupts();
+    }
+}
+
+uint16_t getTickCount()
+{
+    return (uint16_t)host_virtualTicks;
+}
+
+void setTickWakeup(uint16_t tick)
+{
+    host_tickWakeup = tick;
+}
+
+#ifdef STOPWATCH_32BIT
+uint32_t getFreeRunningCounter()
+#else
+uint16_t getFreeRunningCounter()
+#endif /* STOPWATCH_32BIT */
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec) / HOST_COUNTER_NS;
+}
+
+void setPortInterrupt(volatile unsigned char * port, uint8_t bit, uint8_t enable)
+{
+    volatile unsigned char * ie = host_getIE(port);
+    if (enable)
+    {
+        *ie |= bit;
+        if (*host_getIFG(port) & bit)
+        {
+            host_raiseInterrupt(port == &P1IN ? HOST_IRQ_PORT1 : HOST_IRQ_PORT2);
+        }
+    }
+    else
+    {
+        *ie &= ~bit;
+    }
+}
+
+void host_setPin(volatile unsigned char * port, uint8_t bit, uint8_t level)
+{
+    uint8_t wasHigh = *port & bit;
+    uint8_t fallingEdge = ((port == &P1IN) ? P1IES : P2IES) & bit;
+
+    if (level)
+    {
+        *port |= bit;
+    }
+    else
+    {
+        *port &= ~bit;
+    }
+
+    if ((fallingEdge && wasHigh && !level) || (!fallingEdge && !wasHigh && level))
+    {
+        *host_getIFG(port) |= bit;
+        if (*host_getIE(port) & bit)
+        {
+            host_raiseInterrupt(port == &P1IN ? HOST_IRQ_PORT1 : HOST_IRQ_PORT2);
+        }
+    }
+}
+
+void host_setSPISlave(HostSPISlave* slave)
+{
+    host_spiSlave = slave;
+}
+
+void USCI_enable_TXIFG(uint8_t enable)
+{
+    if (enable)
+    {
+        host_USCIIE |= HOST_USCI_TXIFG;
+    }
+    else
+    {
+        host_USCIIE &= ~HOST_USCI_TXIFG;
+    }
+    host_updateUSCI();
+}
+
+void USCI_enable_RXIFG(uint8_t enable)
+{
+    if (enable)
+    {
+        host_USCIIE |= HOST_USCI_RXIFG;
+    }
+    else
+    {
+        host_USCIIE &= ~HOST_USCI_RXIFG;
+    }
+    host_updateUSCI();
+}
+
+void enableUSCI_Interrupt()
+{
+    host_USCIenabled = 1;
+    host_updateUSCI();
+}
+
+void host_setI2CSlave(HostI2CSlave* slave)
+{
+    host_i2cSlave = slave;
+}
+
+void I2C_unsetInterruptFlag(uint8_t flag)
+{
+    host_I2CIFG &= ~flag;
+}
+
+void I2C_setReceive()
+{
+    host_i2cTransmit = 0;
+}
+
+void I2C_setTransmit()
+{
+    host_i2cTransmit = 1;
+}
+
+void I2C_setStart()
+{
+    host_i2cBusy = 1;
+    if (host_i2cTransmit)
+    {
+        host_I2CIFG |= I2C_IFG_TX;
+    }
+    else
+    {
+        host_I2CRXBUF = (host_i2cSlave != 0) ? host_i2cSlave(host_i2cAddress, 0, 1) : 0xFF;
+        host_I2CIFG |= I2C_IFG_RX;
+    }
+    host_raiseInterrupt(HOST_IRQ_I2C);
+}
+
+void I2C_setStop()
+{
+    host_i2cBusy = 0;
+    host_I2CIFG = 0;
+}
+
+uint8_t I2C_isBusy()
+{
+    return host_i2cBusy;
+}
+
+void I2C_setSlaveAddress(uint8_t address)
+{
+    host_i2cAddress = address;
+}
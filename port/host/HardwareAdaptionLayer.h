@@ -0,0 +1,317 @@
+/*
+ * HardwareAdaptionLayer.h
+ *
+ * reference hardware adaption layer for a host (Linux) build
+ *
+ * the RSOS modules run unmodified on the host: the interrupts of the MSP430
+ * are simulated in software and time is virtual. The scheduler, the WaitTimers,
+ * the buttons and the SPI / I2C interrupt paths behave as on the controller,
+ * but every run with the same input gives the same result.
+ *
+ * operation:
+ *      1.  the application registers its interrupt service routines with
+ *          host_setInterruptHandler(), as it would put them into the vector table
+ *      2.  schedulerWait() is the low power mode: pending interrupts are served,
+ *          if there is none, the virtual time advances to the next tick
+ *          (in tickless operation directly to the tick requested by setTickWakeup())
+ *          and the timer interrupt is served. The time does not advance while tasks run,
+ *          unless they call host_advanceTime()
+ *      3.  host_setTickLimit() ends the run: when the virtual time reaches the limit,
+ *          disableScheduler() is called and scheduler() returns when all tasks are done,
+ *          the timer interrupt is served once more at the limit
+ *
+ * an interrupt is served immediately when it is raised with interrupts enabled,
+ * else when exitCritical() enables the interrupts again. Interrupts do not nest,
+ * except in schedulerPreempt() (SCHEDULER_PREEMPTIVE).
+ *
+ * the application still defines the memory of the modules (task_mem, tasks_size, ...)
+ *
+ * the Makefile in this folder builds the benchmarks (benchmark/) and the tests (test/)
+ * against this port: make benchmark, make test
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef HARDWAREADAPTIONLAYER_H_
+#define HARDWAREADAPTIONLAYER_H_
+
+#include <stdint.h>
+
+/**
+ * interrupt source: timer, the tick of the RSOS
+ */
+#define HOST_IRQ_TIMER 0x01
+
+/**
+ * interrupt source: port 1 pin change
+ */
+#define HOST_IRQ_PORT1 0x02
+
+/**
+ * interrupt source: port 2 pin change
+ */
+#define HOST_IRQ_PORT2 0x04
+
+/**
+ * interrupt source: USCI (SPI)
+ */
+#define HOST_IRQ_USCI 0x08
+
+/**
+ * interrupt source: I2C
+ */
+#define HOST_IRQ_I2C 0x10
+
+/**
+ * number of interrupt sources
+ */
+#define HOST_IRQ_NUMBER 5
+
+/**
+ * interrupt service routine of the application
+ */
+typedef void (HostInterruptHandler)();
+
+/**
+ * the virtual time in ticks
+ */
+extern volatile uint32_t host_virtualTicks;
+
+/**
+ * number of calls to schedulerEntered(), one for every pass of the scheduler
+ */
+extern uint32_t host_schedulerPasses;
+
+/**
+ * number of calls to schedulerWait()
+ */
+extern uint32_t host_schedulerWaits;
+
+/**
+ * sets the interrupt service routine for a source
+ * @param source: one of HOST_IRQ_...
+ * @param handler: the function to call, 0 to remove the handler
+ */
+void host_setInterruptHandler(uint8_t source, HostInterruptHandler* handler);
+
+/**
+ * raises an interrupt. It is served immediately if interrupts are enabled,
+ * else when they are enabled again.
+ * @param source: one of HOST_IRQ_...
+ */
+void host_raiseInterrupt(uint8_t source);
+
+/**
+ * serves all pending interrupts, if interrupts are enabled
+ * @return the number of served interrupts
+ */
+uint16_t host_serveInterrupts();
+
+/**
+ * advances the virtual time while a task or an interrupt routine runs, as a long
+ * execution on the controller. The timer interrupt is raised on every tick,
+ * in tickless operation on the tick requested by setTickWakeup()
+ * @param ticks: the ticks the execution takes
+ */
+void host_advanceTime(uint32_t ticks);
+
+/**
+ * sets the virtual time the run ends at, 0 to run endlessly
+ * @param limit: the tick to end the run at
+ */
+void host_setTickLimit(uint32_t limit);
+
+/**
+ * resets the virtual time, the counters, the simulated registers
+ * and the interrupt handlers
+ */
+void host_reset();
+
+/*
+ * scheduler hooks
+ */
+
+static inline void schedulerEntered() __attribute__((always_inline));
+static inline void schedulerEntered()
+{
+    host_schedulerPasses += 1;
+}
+
+static inline void schedulerExited() __attribute__((always_inline));
+static inline void schedulerExited()
+{
+}
+
+/**
+ * the low power mode of the scheduler, serves pending interrupts or
+ * advances the virtual time
+ */
+void schedulerWait();
+
+static inline void waitSchedulerEntered() __attribute__((always_inline));
+static inline void waitSchedulerEntered()
+{
+}
+
+static inline void waitSchedulerExited() __attribute__((always_inline));
+static inline void waitSchedulerExited()
+{
+}
+
+static inline void buttonSchedulerEntered() __attribute__((always_inline));
+static inline void buttonSchedulerEntered()
+{
+}
+
+static inline void buttonSchedulerExited() __attribute__((always_inline));
+static inline void buttonSchedulerExited()
+{
+}
+
+/**
+ * preemptive scheduler hooks (SCHEDULER_PREEMPTIVE), called by schedulerPreempt()
+ * in an interrupt routine: enables the interrupts for the tasks,
+ * pending interrupts are served, and disables them again at the end.
+ * on the MSP430 these are __enable_interrupt() / __disable_interrupt()
+ */
+void preemptSchedulerEntered();
+void preemptSchedulerExited();
+
+/**
+ * disables interrupts
+ * @return the former interrupt state
+ */
+uint16_t enterCritical();
+
+/**
+ * restores the interrupt state, pending interrupts are served when enabled
+ * @param state: the state returned by enterCritical()
+ */
+void exitCritical(uint16_t state);
+
+/*
+ * tick source
+ */
+
+/**
+ * @return the virtual time, the lower 16 bit
+ */
+uint16_t getTickCount();
+
+/**
+ * requests the timer interrupt at the tick (tickless operation)
+ * @param tick: the tick to wake up at
+ */
+void setTickWakeup(uint16_t tick);
+
+/**
+ * the free running counter for the stopwatch, real time read by clock_gettime()
+ * in units of HOST_COUNTER_NS nanoseconds
+ */
+#ifndef HOST_COUNTER_NS
+#define HOST_COUNTER_NS 1000
+#endif /* HOST_COUNTER_NS */
+
+#ifdef STOPWATCH_32BIT
+uint32_t getFreeRunningCounter();
+#else
+uint16_t getFreeRunningCounter();
+#endif /* STOPWATCH_32BIT */
+
+/*
+ * ports, named as in the MSP430 headers
+ * a pin change is simulated with host_setPin()
+ */
+
+extern volatile unsigned char P1IN, P1OUT, P1DIR, P1IE, P1IES, P1IFG;
+extern volatile unsigned char P2IN, P2OUT, P2DIR, P2IE, P2IES, P2IFG;
+
+/**
+ * enables / disables the interrupt of a pin
+ * @param port: the input register of the port (&P1IN or &P2IN)
+ * @param bit: the pin
+ * @param enable: 1 to enable, 0 to disable
+ */
+void setPortInterrupt(volatile unsigned char * port, uint8_t bit, uint8_t enable);
+
+/**
+ * changes the level of an input pin. if the edge matches the edge select
+ * register (PxIES set: high to low), the interrupt flag is set and the
+ * port interrupt is raised if enabled
+ * @param port: the input register of the port (&P1IN or &P2IN)
+ * @param bit: the pin
+ * @param level: 1 high, 0 low
+ */
+void host_setPin(volatile unsigned char * port, uint8_t bit, uint8_t level);
+
+/*
+ * USCI in SPI mode
+ * the USCI interrupt service routine reads host_USCIIFG to find the cause.
+ * after every transmit interrupt the byte in host_USCITXBUF is shifted out,
+ * the byte shifted in is put to host_USCIRXBUF and the receive interrupt is raised.
+ * without a slave, the interface is looped back
+ */
+
+#define HOST_USCI_RXIFG 0x01
+#define HOST_USCI_TXIFG 0x02
+
+extern volatile unsigned char host_USCITXBUF;
+extern volatile unsigned char host_USCIRXBUF;
+extern volatile uint8_t host_USCIIFG;
+
+/**
+ * the SPI slave
+ * @param byte: the byte sent by the master
+ * @return the byte sent to the master
+ */
+typedef uint8_t (HostSPISlave)(uint8_t byte);
+
+/**
+ * sets the SPI slave, 0 for loopback
+ */
+void host_setSPISlave(HostSPISlave* slave);
+
+void USCI_enable_TXIFG(uint8_t enable);
+void USCI_enable_RXIFG(uint8_t enable);
+void enableUSCI_Interrupt();
+
+/*
+ * I2C master
+ * the I2C interrupt service routine reads host_I2CIFG to find the cause.
+ * the bytes written to I2C_WRITEADDRESS are passed to the slave,
+ * the bytes of the slave are put to I2C_READADDRESS
+ */
+
+extern volatile unsigned char host_I2CTXBUF;
+extern volatile unsigned char host_I2CRXBUF;
+extern volatile uint8_t host_I2CIFG;
+
+#define I2C_WRITEADDRESS host_I2CTXBUF
+#define I2C_READADDRESS host_I2CRXBUF
+#define I2C_IFG_RX 0x01
+#define I2C_IFG_TX 0x02
+
+/**
+ * the I2C slave
+ * @param address: the 7 bit address of the slave
+ * @param byte: the byte written by the master, the return value is ignored
+ *        (read is 0) or read by the master (read is 1)
+ * @param read: 1 if the master reads
+ */
+typedef uint8_t (HostI2CSlave)(uint8_t address, uint8_t byte, uint8_t read);
+
+/**
+ * sets the I2C slave, 0 if no slave answers (reads return 0xFF)
+ */
+void host_setI2CSlave(HostI2CSlave* slave);
+
+void I2C_unsetInterruptFlag(uint8_t flag);
+void I2C_setReceive();
+void I2C_setTransmit();
+void I2C_setStart();
+void I2C_setStop();
+uint8_t I2C_isBusy();
+void I2C_setSlaveAddress(uint8_t address);
+
+#endif /* HARDWAREADAPTIONLAYER_H_ */
@@ -0,0 +1,76 @@
+/*
+ * RSOSDefines.h
+ *
+ * reference configuration for the host (Linux) build,
+ * see HardwareAdaptionLayer.h in this folder.
+ *
+ * the sizes can be overridden on the compiler command line (-D...),
+ * a module is excluded by removing its define
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef RSOSDEFINES_H_
+#define RSOSDEFINES_H_
+
+/*
+ * Task.h
+ */
+#ifndef MAXTASKS
+#define MAXTASKS 32
+#endif /* MAXTASKS */
+
+/*
+ * WaitTimer.h
+ */
+#ifndef MAXTIMERS
+#define MAXTIMERS 16
+#endif /* MAXTIMERS */
+
+/*
+ * input/Buttons.h, input/LongPressButton.h
+ */
+#ifndef MAXBUTTONS
+#define MAXBUTTONS 4
+#endif /* MAXBUTTONS */
+
+#ifndef MAXLONGPRESSBUTTONS
+#define MAXLONGPRESSBUTTONS 2
+#endif /* MAXLONGPRESSBUTTONS */
+
+/*
+ * buffer/BasicBuffer.h
+ */
+#ifndef MAXBUFFER_VOID
+#define MAXBUFFER_VOID 8
+#endif /* MAXBUFFER_VOID */
+
+/*
+ * SerialInterface/SPIOperation.h
+ */
+#ifndef MAXSHIFTREGISTER
+#define MAXSHIFTREGISTER 2
+#endif /* MAXSHIFTREGISTER */
+
+#define SHIFTREGISTER_ACTIVATE_PRIORITY 3
+#define SHIFTREGISTER_STROBESET_PRIORITY 3
+#define SHIFTREGISTER_STROBERESET_PRIORITY 3
+
+/*
+ * SerialInterface/I2C_Operation.h
+ */
+#ifndef I2CDATASIZE
+#define I2CDATASIZE 2
+#endif /* I2CDATASIZE */
+
+/*
+ * division/RSOSDivision.h
+ */
+#define USE_RSOSDIVISION
+#define RSOSDIVISION_16BIT
+#ifndef MAXRSOSDIVISION
+#define MAXRSOSDIVISION 2
+#endif /* MAXRSOSDIVISION */
+
+#endif /* RSOSDEFINES_H_ */
@@ -0,0 +1,177 @@
+/*
+ * AgingBenchmark.c
+ *
+ * host stress benchmark of the latency from an interrupt to the task it
+ * schedules with fixed priorities and with SCHEDULER_AGING, for probe tasks
+ * of a high, a middle and the lowest priority
+ *
+ * on every tick the timer interrupt schedules the load tasks (priorities 8 to 15,
+ * cyclic tasks of BENCHMARK_CYCLES executions, each runs a short busy loop) and
+ * the probe tasks. With fixed priorities a probe below the load waits for all
+ * executions of the load, with aging it is executed in between. The latency is
+ * measured in real time and in the executions of other tasks the probe waited for
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "Benchmark.h"
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+/**
+ * the virtual ticks of one run
+ */
+#define BENCHMARK_TICKS 20000
+
+/**
+ * the busy loops of a load task
+ */
+#define BENCHMARK_WORK 100
+
+/**
+ * the number of load tasks, priorities 8 to 15
+ */
+#define BENCHMARK_LOADTASKS 8
+
+#define BENCHMARK_PROBES 3
+
+/**
+ * the priorities of the probe tasks
+ */
+static const uint8_t benchmark_probePriorities[BENCHMARK_PROBES] = {12, 7, 0};
+
+/**
+ * Probe structure
+ * Fields:
+ *  scheduledAt: the real time the interrupt scheduled the probe
+ *  executionsAt: benchmark_executions when the interrupt scheduled the probe
+ *  latency: the real time latency
+ *  maxWaited: the most executions of other tasks the probe waited for
+ */
+typedef struct BenchmarkProbe_t {
+    Task* task;
+    uint64_t scheduledAt;
+    uint32_t executionsAt;
+    BenchmarkLatency latency;
+    uint32_t maxWaited;
+} BenchmarkProbe;
+
+static Task* benchmark_load[BENCHMARK_LOADTASKS];
+static BenchmarkProbe benchmark_probes[BENCHMARK_PROBES];
+static uint32_t benchmark_executions = 0;
+
+static void loadTask()
+{
+    Benchmark_work(BENCHMARK_WORK);
+    benchmark_executions += 1;
+}
+
+static inline void probe(BenchmarkProbe* probe)
+{
+    uint32_t waited = benchmark_executions - probe->executionsAt;
+    Benchmark_latencyRecord(&probe->latency, Benchmark_now() - probe->scheduledAt);
+    if (waited > probe->maxWaited)
+    {
+        probe->maxWaited = waited;
+    }
+    benchmark_executions += 1;
+}
+
+static void highProbeTask()
+{
+    probe(&benchmark_probes[0]);
+}
+
+static void middleProbeTask()
+{
+    probe(&benchmark_probes[1]);
+}
+
+static void lowProbeTask()
+{
+    probe(&benchmark_probes[2]);
+}
+
+static void timerISR()
+{
+    uint8_t i;
+    for (i=0; i<BENCHMARK_LOADTASKS; i++)
+    {
+        scheduleTask(benchmark_load[i]);
+    }
+    for (i=0; i<BENCHMARK_PROBES; i++)
+    {
+        benchmark_probes[i].scheduledAt = Benchmark_now();
+        benchmark_probes[i].executionsAt = benchmark_executions;
+        scheduleTask(benchmark_probes[i].task);
+    }
+}
+
+/**
+ * runs the scheduler with the load tasks and the probes and prints one line per probe
+ * @param cycles: the executions of a load task per tick (1 to 16)
+ */
+static void run(uint8_t cycles)
+{
+    static void (* const probeTasks[BENCHMARK_PROBES])() = {highProbeTask, middleProbeTask, lowProbeTask};
+    uint8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    benchmark_executions = 0;
+    for (i=0; i<BENCHMARK_LOADTASKS; i++)
+    {
+        benchmark_load[i] = addTask(8 + i, loadTask);
+        if (cycles > 1)
+        {
+            setTaskCyclic(benchmark_load[i], cycles);
+        }
+    }
+    for (i=0; i<BENCHMARK_PROBES; i++)
+    {
+        benchmark_probes[i].task = addTask(benchmark_probePriorities[i], probeTasks[i]);
+        benchmark_probes[i].maxWaited = 0;
+        Benchmark_latencyReset(&benchmark_probes[i].latency);
+    }
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setTickLimit(BENCHMARK_TICKS);
+    enableScheduler();
+    scheduler();
+
+    for (i=0; i<BENCHMARK_PROBES; i++)
+    {
+        printf("%14u %10u  ", cycles, benchmark_probePriorities[i]);
+        Benchmark_latencyPrint(&benchmark_probes[i].latency);
+        printf(" %14lu\n", (unsigned long)benchmark_probes[i].maxWaited);
+    }
+}
+
+int main()
+{
+#ifdef SCHEDULER_AGING
+    printf("scheduler: aging, priority rises every %d calls of getNextTaskNumber()\n", SCHEDULER_AGING);
+#else
+    printf("scheduler: fixed priorities\n");
+#endif /* SCHEDULER_AGING */
+    printf("%d ticks per run, %d load tasks of priority 8 to 15, %d busy loops per execution\n",
+           BENCHMARK_TICKS, BENCHMARK_LOADTASKS, BENCHMARK_WORK);
+    printf("%14s %10s  %s %14s\n", "load cycles", "priority",
+           "latency [us] min / avg / max", "max waited");
+
+    run(1);
+    run(4);
+    run(16);
+    return 0;
+}
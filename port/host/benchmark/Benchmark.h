@@ -0,0 +1,97 @@
+/*
+ * Benchmark.h
+ *
+ * helpers of the host benchmarks: real time, a busy loop as synthetic
+ * load and the statistics of measured latencies
+ *
+ * the virtual time of the host port does not advance while a task runs,
+ * so the costs are measured in real time (clock_gettime())
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Latency statistics structure
+ * Fields:
+ *  min, max, sum: in nanoseconds
+ *  count: the number of recorded latencies
+ */
+typedef struct BenchmarkLatency_t {
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+    uint32_t count;
+} BenchmarkLatency;
+
+/**
+ * @return the real time in nanoseconds
+ */
+static inline uint64_t Benchmark_now() __attribute__((always_inline));
+static inline uint64_t Benchmark_now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * synthetic work of a task
+ * @param loops: the number of loops
+ */
+static inline void Benchmark_work(uint16_t loops) __attribute__((always_inline));
+static inline void Benchmark_work(uint16_t loops)
+{
+    volatile uint16_t i;
+    for (i=0; i<loops; i++)
+    {
+    }
+}
+
+static inline void Benchmark_latencyReset(BenchmarkLatency* latency) __attribute__((always_inline));
+static inline void Benchmark_latencyReset(BenchmarkLatency* latency)
+{
+    latency->min = UINT64_MAX;
+    latency->max = 0;
+    latency->sum = 0;
+    latency->count = 0;
+}
+
+static inline void Benchmark_latencyRecord(BenchmarkLatency* latency, uint64_t nanoseconds) __attribute__((always_inline));
+static inline void Benchmark_latencyRecord(BenchmarkLatency* latency, uint64_t nanoseconds)
+{
+    if (nanoseconds < latency->min)
+    {
+        latency->min = nanoseconds;
+    }
+    if (nanoseconds > latency->max)
+    {
+        latency->max = nanoseconds;
+    }
+    latency->sum += nanoseconds;
+    latency->count += 1;
+}
+
+/**
+ * prints min / avg / max in microseconds
+ */
+static inline void Benchmark_latencyPrint(BenchmarkLatency* latency) __attribute__((always_inline));
+static inline void Benchmark_latencyPrint(BenchmarkLatency* latency)
+{
+    if (latency->count == 0)
+    {
+        printf("%8s %8s %8s", "-", "-", "-");
+        return;
+    }
+    printf("%8.2f %8.2f %8.2f", latency->min / 1000.0,
+           (double)latency->sum / latency->count / 1000.0, latency->max / 1000.0);
+}
+
+#endif /* BENCHMARK_H_ */
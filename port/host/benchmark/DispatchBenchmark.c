@@ -0,0 +1,124 @@
+/*
+ * DispatchBenchmark.c
+ *
+ * host benchmark of the scheduler: dispatches per second and the latency
+ * from an interrupt to the task it schedules, under synthetic load
+ *
+ * on every tick the timer interrupt schedules the load tasks (priorities 0 to 7,
+ * each runs a short busy loop) and the probe task (priority 4). The interrupt
+ * stores the time, the probe task measures the latency. The load tasks of
+ * priority 5 to 7 run before the probe, they are part of the latency.
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "Benchmark.h"
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+/**
+ * the virtual ticks of one run
+ */
+#define BENCHMARK_TICKS 20000
+
+/**
+ * the busy loops of a load task
+ */
+#define BENCHMARK_WORK 100
+
+#define BENCHMARK_MAXLOAD 24
+
+static Task* benchmark_load[BENCHMARK_MAXLOAD];
+static uint8_t benchmark_loadTasks = 0;
+static Task* benchmark_probe = 0;
+
+static uint32_t benchmark_dispatches = 0;
+static uint64_t benchmark_scheduledAt = 0;
+static BenchmarkLatency benchmark_latency;
+
+static void loadTask()
+{
+    Benchmark_work(BENCHMARK_WORK);
+    benchmark_dispatches += 1;
+}
+
+static void probeTask()
+{
+    Benchmark_latencyRecord(&benchmark_latency, Benchmark_now() - benchmark_scheduledAt);
+    benchmark_dispatches += 1;
+}
+
+static void timerISR()
+{
+    uint8_t i;
+    for (i=0; i<benchmark_loadTasks; i++)
+    {
+        scheduleTask(benchmark_load[i]);
+    }
+    benchmark_scheduledAt = Benchmark_now();
+    scheduleTask(benchmark_probe);
+}
+
+/**
+ * runs the scheduler with the load tasks and prints one line
+ * @param loadTasks: the number of load tasks
+ */
+static void run(uint8_t loadTasks)
+{
+    uint8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    benchmark_loadTasks = loadTasks;
+    for (i=0; i<loadTasks; i++)
+    {
+        benchmark_load[i] = addTask(i & 0x07, loadTask);
+    }
+    benchmark_probe = addTask(4, probeTask);
+    benchmark_dispatches = 0;
+    Benchmark_latencyReset(&benchmark_latency);
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setTickLimit(BENCHMARK_TICKS);
+    enableScheduler();
+
+    uint64_t start = Benchmark_now();
+    scheduler();
+    uint64_t duration = Benchmark_now() - start;
+
+    printf("%10u %14.0f %10.1f  ", loadTasks,
+           benchmark_dispatches * 1e9 / duration,
+           (double)host_schedulerPasses / BENCHMARK_TICKS);
+    Benchmark_latencyPrint(&benchmark_latency);
+    printf("\n");
+}
+
+int main()
+{
+    printf("scheduler: %s\n",
+#ifdef SCHEDULER_READYBITMAP
+           "ready bitmap"
+#else
+           "scan"
+#endif /* SCHEDULER_READYBITMAP */
+           );
+    printf("%d ticks per run, %d busy loops per load task\n", BENCHMARK_TICKS, BENCHMARK_WORK);
+    printf("%10s %14s %10s  %s\n", "load tasks", "dispatches/s", "passes/tick", "ISR to task latency [us] min / avg / max");
+
+    run(0);
+    run(4);
+    run(8);
+    run(BENCHMARK_MAXLOAD);
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * EDFBenchmark.c
+ *
+ * host benchmark of the CPU utilization reached with earliest deadline first
+ * (SCHEDULER_EDF) and with fixed rate monotonic priorities (the shorter the
+ * period, the higher the priority). Three periodic tasks with the deadline
+ * equal to the period are scaled to a utilization of 0.60 to 1.00 (rounded
+ * down to full ticks)
+ *
+ * a job of C ticks is a cyclic task of C cycles, every cycle takes one tick of
+ * virtual time, the scheduler chooses the task again after every cycle. The
+ * timer interrupt posts the releases to DeferredWork. A job is missed if its
+ * task is still active at the next release, the release is dropped then.
+ * the CPU utilization is the share of ticks a task ran, the cost is the real
+ * time of the run per tick
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "DeferredWork.h"
+#include "Benchmark.h"
+
+#ifndef MAXDEFERREDWORK
+#error "build with -DMAXDEFERREDWORK"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the ticks of one run, ten hyperperiods of the task set
+ */
+#define BENCHMARK_TICKS 15400UL
+
+/**
+ * the number of tasks
+ */
+#define BENCHMARK_TASKS 3
+
+/**
+ * the periods of the tasks, ascending
+ */
+static const uint16_t benchmark_periods[BENCHMARK_TASKS] = {20, 28, 44};
+
+static Task* benchmark_tasks[BENCHMARK_TASKS];
+static uint32_t benchmark_misses = 0;
+static uint32_t benchmark_busyTicks = 0;
+
+static void jobTask()
+{
+    benchmark_busyTicks += 1;
+    host_advanceTime(1);
+}
+
+/**
+ * releases the next job of a task, posted by the timer interrupt
+ */
+static void release(void* argument)
+{
+    Task* task = (Task*) argument;
+    if (task->status & Task_isActive)
+    {
+        benchmark_misses += 1;
+        return;
+    }
+    scheduleTask(task);
+}
+
+static void timerISR()
+{
+    uint8_t i;
+
+    Task_resetDelayState();
+    Timer_ISR();
+    if (rsos_tickCount >= BENCHMARK_TICKS)
+    {
+        disableScheduler();
+        return;
+    }
+    for (i=0; i<BENCHMARK_TASKS; i++)
+    {
+        if (rsos_tickCount % benchmark_periods[i] == 0)
+        {
+            DeferredWork_post(release, benchmark_tasks[i]);
+        }
+    }
+}
+
+/**
+ * runs the task set scaled to a utilization and prints one line
+ * @param percent: the utilization to scale the task set to in percent
+ */
+static void run(uint8_t percent)
+{
+    uint8_t i;
+    double utilization = 0;
+
+    host_reset();
+    tasks_size = 0;
+    timers_size = 0;
+    rsos_tickCount = 0;
+    benchmark_misses = 0;
+    benchmark_busyTicks = 0;
+    Timer_initOperation();
+
+    for (i=0; i<BENCHMARK_TASKS; i++)
+    {
+        // every task takes a third of the utilization, the last one the rest,
+        // rounded down to full ticks
+        uint8_t cost = (i < BENCHMARK_TASKS - 1)
+                ? percent * benchmark_periods[i] / (100 * BENCHMARK_TASKS)
+                : (uint8_t)((percent / 100.0 - utilization) * benchmark_periods[i]);
+        utilization += (double)cost / benchmark_periods[i];
+
+        benchmark_tasks[i] = addTask(BENCHMARK_TASKS - i, jobTask);
+        setTaskCyclic(benchmark_tasks[i], cost);
+#ifdef SCHEDULER_EDF
+        setTaskDeadline(benchmark_tasks[i], benchmark_periods[i]);
+#endif /* SCHEDULER_EDF */
+        scheduleTask(benchmark_tasks[i]);
+    }
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    enableScheduler();
+    uint64_t start = Benchmark_now();
+    scheduler();
+    uint64_t duration = Benchmark_now() - start;
+
+    printf("%13.3f %13lu %13.1f %13.1f\n", utilization, (unsigned long)benchmark_misses,
+           benchmark_busyTicks * 100.0 / BENCHMARK_TICKS, (double)duration / BENCHMARK_TICKS);
+}
+
+int main()
+{
+    uint8_t percent;
+
+    printf("scheduler: %s, periods %u/%u/%u ticks, %lu ticks\n",
+#ifdef SCHEDULER_EDF
+           "earliest deadline first",
+#else
+           "fixed priority, rate monotonic",
+#endif /* SCHEDULER_EDF */
+           benchmark_periods[0], benchmark_periods[1], benchmark_periods[2], BENCHMARK_TICKS);
+    printf("%13s %13s %13s %13s\n", "utilization", "missed jobs", "CPU used [%]", "cost [ns/tick]");
+    for (percent=60; percent<=100; percent+=5)
+    {
+        run(percent);
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * MessageQueueBenchmark.c
+ *
+ * host benchmark of the throughput of the MessageQueue between two tasks:
+ * a producer task reserves, writes and commits a batch of messages, the consumer
+ * task (scheduled by the commit) reads and releases all of them and schedules
+ * the producer again. Reported in messages per second of real time, with the
+ * scheduler, the commit and the check task (follow-up task of the consumer) included
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Task.h"
+#include "buffer/MessageQueue.h"
+#include "Benchmark.h"
+
+#ifndef MAXMESSAGEQUEUES
+#error "build with -DMAXMESSAGEQUEUES"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+/**
+ * the messages of one run
+ */
+#define BENCHMARK_MESSAGES 2000000UL
+
+/**
+ * the number of messages the queue holds
+ */
+#define BENCHMARK_QUEUESIZE 16
+
+/**
+ * the largest message size in bytes
+ */
+#define BENCHMARK_MAXSIZE 32
+
+static uint8_t benchmark_data[BENCHMARK_QUEUESIZE * BENCHMARK_MAXSIZE];
+static uint8_t benchmark_message[BENCHMARK_MAXSIZE];
+static uint8_t benchmark_read[BENCHMARK_MAXSIZE];
+
+static MessageQueue* benchmark_queue = 0;
+static Task* benchmark_producer = 0;
+static uint8_t benchmark_size = 0;
+static uint8_t benchmark_batch = 0;
+static uint32_t benchmark_produced = 0;
+static uint32_t benchmark_consumed = 0;
+
+static void producerTask()
+{
+    uint8_t i;
+    for (i=0; i<benchmark_batch; i++)
+    {
+        void* message = MessageQueue_reserve(benchmark_queue);
+        if (message == 0)
+        {
+            break;
+        }
+        benchmark_message[0] = (uint8_t)benchmark_produced;
+        memcpy(message, benchmark_message, benchmark_size);
+        MessageQueue_commit(benchmark_queue);
+        benchmark_produced += 1;
+    }
+}
+
+static void consumerTask()
+{
+    void* message;
+    while ((message = MessageQueue_peek(benchmark_queue)) != 0)
+    {
+        memcpy(benchmark_read, message, benchmark_size);
+        MessageQueue_release(benchmark_queue);
+        benchmark_consumed += 1;
+    }
+    if (benchmark_produced < BENCHMARK_MESSAGES)
+    {
+        scheduleTask(benchmark_producer);
+    }
+    else
+    {
+        disableScheduler();
+    }
+}
+
+/**
+ * runs the producer and the consumer and prints one line
+ * @param size: the size of a message in bytes
+ * @param batch: the number of messages the producer commits per run
+ */
+static void run(uint8_t size, uint8_t batch)
+{
+    host_reset();
+    tasks_size = 0;
+    buffer_size = 0;
+    messageQueue_size = 0;
+    benchmark_size = size;
+    benchmark_batch = batch;
+    benchmark_produced = 0;
+    benchmark_consumed = 0;
+
+    initMessageQueueOperation();
+    benchmark_producer = addTask(1, producerTask);
+    benchmark_queue = initMessageQueue(benchmark_data, BENCHMARK_QUEUESIZE, size, addTask(2, consumerTask));
+
+    // the scheduler returns when the last messages are consumed
+    scheduleTask(benchmark_producer);
+    enableScheduler();
+    uint64_t start = Benchmark_now();
+    scheduler();
+    uint64_t duration = Benchmark_now() - start;
+
+    printf("%14u %8u %16.0f %14.1f\n", size, batch,
+           benchmark_consumed * 1e9 / duration, (double)duration / benchmark_consumed);
+}
+
+int main()
+{
+    printf("message queue of %u messages, %lu messages per run\n", BENCHMARK_QUEUESIZE, BENCHMARK_MESSAGES);
+    printf("%14s %8s %16s %14s\n", "message [Byte]", "batch", "messages/s", "ns/message");
+    run(4, 1);
+    run(4, BENCHMARK_QUEUESIZE);
+    run(BENCHMARK_MAXSIZE, 1);
+    run(BENCHMARK_MAXSIZE, BENCHMARK_QUEUESIZE);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * ReadyBitmapBenchmark.c
+ *
+ * host benchmark of the dispatch cost of the scan and the ready bitmap
+ * scheduler (SCHEDULER_READYBITMAP) for 8, 32 and 127 tasks
+ *
+ * one active: on every tick the timer interrupt schedules one task of the table
+ *             (in turn), the cost is the time per tick: idle to dispatch and back
+ * all active: on every tick all tasks are scheduled, the cost is the time per dispatch
+ *
+ * the tasks have the priorities 0 to 15 and do no work
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "Benchmark.h"
+
+#if MAXTASKS < 127
+#error "build with -DMAXTASKS=127"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+/**
+ * the dispatches of one run
+ */
+#define BENCHMARK_DISPATCHES 2000000UL
+
+static uint32_t benchmark_dispatches = 0;
+static uint8_t benchmark_scheduleAll = 0;
+static int8_t benchmark_nextTask = 0;
+
+static void emptyTask()
+{
+    benchmark_dispatches += 1;
+}
+
+static void timerISR()
+{
+    if (benchmark_scheduleAll)
+    {
+        int8_t i;
+        for (i=0; i<tasks_size; i++)
+        {
+            scheduleTask(&task_mem[i]);
+        }
+    }
+    else
+    {
+        scheduleTask(&task_mem[benchmark_nextTask]);
+        benchmark_nextTask = (benchmark_nextTask + 1) % tasks_size;
+    }
+}
+
+/**
+ * runs the scheduler
+ * @param tasks: the size of the task table
+ * @param scheduleAll: 1 to schedule all tasks on every tick
+ * @return nanoseconds per dispatch
+ */
+static double run(int8_t tasks, uint8_t scheduleAll)
+{
+    int8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    for (i=0; i<tasks; i++)
+    {
+        addTask(i & priorityMask, emptyTask);
+    }
+    benchmark_dispatches = 0;
+    benchmark_scheduleAll = scheduleAll;
+    benchmark_nextTask = 0;
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setTickLimit(scheduleAll ? BENCHMARK_DISPATCHES / tasks : BENCHMARK_DISPATCHES);
+    enableScheduler();
+
+    uint64_t start = Benchmark_now();
+    scheduler();
+    uint64_t duration = Benchmark_now() - start;
+
+    return (double)duration / benchmark_dispatches;
+}
+
+int main()
+{
+    static const int8_t tasks[] = {8, 32, 127};
+    uint8_t i;
+
+    printf("scheduler: %s\n",
+#ifdef SCHEDULER_READYBITMAP
+           "ready bitmap"
+#else
+           "scan"
+#endif /* SCHEDULER_READYBITMAP */
+           );
+    printf("%6s %22s %22s\n", "tasks", "one active [ns/tick]", "all active [ns/disp.]");
+    for (i=0; i<sizeof(tasks); i++)
+    {
+        double one = run(tasks[i], 0);
+        double all = run(tasks[i], 1);
+        printf("%6d %22.1f %22.1f\n", tasks[i], one, all);
+    }
+    return 0;
+}
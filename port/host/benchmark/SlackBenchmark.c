@@ -0,0 +1,147 @@
+/*
+ * SlackBenchmark.c
+ *
+ * host benchmark of the wakeups of the scheduler in tickless operation with
+ * 20 cyclic timers of mixed periods, without and with a slack of a quarter
+ * of the period (at most 255 ticks, WAITTIMER_SLACK)
+ *
+ * the virtual time runs BENCHMARK_TICKS ticks, a tick is one millisecond.
+ * a wakeup is a return from schedulerWait(), as from the low power mode.
+ * all timers schedule the same task, the expiries are counted by the callback
+ * of the timers. The timers are started together or every BENCHMARK_STAGGER
+ * ticks, as if started by different tasks
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+
+#ifndef WAITTIMER_TICKLESS
+#error "build with -DWAITTIMER_TICKLESS"
+#endif
+#ifndef WAITTIMER_CALLBACK
+#error "build with -DWAITTIMER_CALLBACK"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the virtual ticks of one run, one minute
+ */
+#define BENCHMARK_TICKS 60000UL
+
+/**
+ * the number of timers
+ */
+#define BENCHMARK_TIMERS 20
+
+#if MAXTIMERS < BENCHMARK_TIMERS
+#error "build with -DMAXTIMERS=20 or more"
+#endif
+
+/**
+ * the ticks between the starts of two timers if staggered
+ */
+#define BENCHMARK_STAGGER 7
+
+static uint32_t benchmark_expiries = 0;
+static uint32_t benchmark_taskRuns = 0;
+
+static void timerISR()
+{
+    Task_resetDelayState();
+    Timer_ISR();
+}
+
+static void expiredTask()
+{
+    benchmark_taskRuns += 1;
+}
+
+static void expiredCallback(void* argument)
+{
+    benchmark_expiries += 1;
+}
+
+/**
+ * runs the scheduler with cyclic timers of the periods and prints one line
+ * @param name: the name of the timer set
+ * @param periods: the wait times of the timers, BENCHMARK_TIMERS entries
+ * @param stagger: the ticks between the starts of two timers
+ */
+static void run(const char* name, const waittime_t* periods, uint8_t stagger)
+{
+    uint8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    timers_size = 0;
+    benchmark_expiries = 0;
+    benchmark_taskRuns = 0;
+    Timer_initOperation();
+
+    Task* task = addTask(0, expiredTask);
+    for (i=0; i<BENCHMARK_TIMERS; i++)
+    {
+#ifdef WAITTIMER_SLACK
+        waittime_t slack = periods[i] / 4;
+        WaitTimer* timer = initWaitTimer_slack(periods[i], (slack > 255) ? 255 : slack);
+#else
+        WaitTimer* timer = initWaitTimer(periods[i]);
+#endif /* WAITTIMER_SLACK */
+        setTimerCyclic(timer);
+        setTaskOnStop(timer, task);
+        setCallbackOnStop(timer, expiredCallback, 0);
+        setTimer(timer);
+        host_advanceTime(stagger);
+    }
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setTickLimit(BENCHMARK_TICKS);
+    enableScheduler();
+    scheduler();
+
+    printf("%-28s %10lu %10lu %12.1f\n", name, (unsigned long)benchmark_expiries,
+           (unsigned long)benchmark_taskRuns, host_schedulerWaits * 1000.0 / BENCHMARK_TICKS);
+}
+
+int main()
+{
+    // powers of two and decimal periods, as used for polling, blinking and timeouts.
+    // started together, the decimal periods expire on common ticks without slack,
+    // the slack rounds them up to multiples of powers of two
+    static const waittime_t mixed[BENCHMARK_TIMERS] = {
+            8, 10, 16, 20, 25, 32, 40, 50, 64, 100,
+            128, 150, 200, 250, 256, 300, 500, 512, 750, 1000};
+    // pairwise coprime periods, the expiries of the timers do not coincide without slack
+    static const waittime_t coprime[BENCHMARK_TIMERS] = {
+            11, 13, 17, 19, 23, 29, 31, 37, 41, 43,
+            47, 53, 59, 61, 67, 71, 73, 79, 83, 89};
+
+    printf("timer: tickless, %s, %u timers, %lu ticks of 1 ms\n",
+#ifdef WAITTIMER_SLACK
+           "slack of a quarter period",
+#else
+           "no slack",
+#endif /* WAITTIMER_SLACK */
+           BENCHMARK_TIMERS, BENCHMARK_TICKS);
+    printf("%-28s %10s %10s %12s\n", "timer periods", "expiries", "task runs", "wakeups/s");
+    run("mixed 8..1000 ms, together", mixed, 0);
+    run("mixed 8..1000 ms, staggered", mixed, BENCHMARK_STAGGER);
+    run("coprime 11..89 ms, staggered", coprime, BENCHMARK_STAGGER);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * TicklessBenchmark.c
+ *
+ * host benchmark of the wakeups of the scheduler with a tick on every
+ * timer period and in tickless operation (WAITTIMER_TICKLESS)
+ *
+ * the virtual time runs BENCHMARK_TICKS ticks, a tick is one millisecond.
+ * a wakeup is a return from schedulerWait(), as from the low power mode
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the virtual ticks of one run, one minute
+ */
+#define BENCHMARK_TICKS 60000UL
+
+static uint32_t benchmark_expiries = 0;
+
+static void timerISR()
+{
+    Task_resetDelayState();
+    Timer_ISR();
+}
+
+static void expiredTask()
+{
+    benchmark_expiries += 1;
+}
+
+/**
+ * runs the scheduler with cyclic timers of the periods
+ * @param periods: the wait times of the timers, 0 terminated
+ */
+static void run(const waittime_t* periods)
+{
+    uint8_t i;
+    char label[32];
+    int length = 0;
+
+    host_reset();
+    tasks_size = 0;
+    timers_size = 0;
+    benchmark_expiries = 0;
+    Timer_initOperation();
+
+    Task* task = addTask(0, expiredTask);
+    for (i=0; periods[i] != 0; i++)
+    {
+        WaitTimer* timer = initWaitTimer(periods[i]);
+        setTimerCyclic(timer);
+        setTaskOnStop(timer, task);
+        setTimer(timer);
+        length += snprintf(&label[length], sizeof(label) - length, "%s%u",
+                           (i == 0) ? "" : "/", (unsigned int)periods[i]);
+    }
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setTickLimit(BENCHMARK_TICKS);
+    enableScheduler();
+    scheduler();
+
+    printf("%-22s %10lu %14.1f\n", label, (unsigned long)benchmark_expiries,
+           host_schedulerWaits * 1000.0 / BENCHMARK_TICKS);
+}
+
+int main()
+{
+    static const waittime_t fast[] = {10, 0};
+    static const waittime_t slow[] = {100, 1000, 0};
+    static const waittime_t mixed[] = {10, 250, 1000, 0};
+
+    printf("timer: %s, %lu ticks of 1 ms\n",
+#ifdef WAITTIMER_TICKLESS
+           "tickless",
+#else
+           "tick",
+#endif /* WAITTIMER_TICKLESS */
+           BENCHMARK_TICKS);
+    printf("%-22s %10s %14s\n", "timer periods [ms]", "task runs", "wakeups/s");
+    run(fast);
+    run(slow);
+    run(mixed);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * TimerCallbackBenchmark.c
+ *
+ * host harness of the reaction latency to a WaitTimer expiry: the callback
+ * (WAITTIMER_CALLBACK, called in the timer interrupt) and the task on stop
+ * (executed by the scheduler). Both are set on the same cyclic timer.
+ *
+ * the latency is measured from the entry of the timer interrupt. On every tick
+ * the interrupt also schedules the load tasks (priorities 1 to 7, each runs a
+ * short busy loop), the task on stop has priority 0 and runs after them
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "Benchmark.h"
+
+#ifndef WAITTIMER_CALLBACK
+#error "build with -DWAITTIMER_CALLBACK"
+#endif
+#ifdef WAITTIMER_TASK
+#error "the callback is called in the interrupt only without WAITTIMER_TASK"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the virtual ticks of one run
+ */
+#define BENCHMARK_TICKS 50000UL
+
+/**
+ * the period of the timer in ticks
+ */
+#define BENCHMARK_PERIOD 5
+
+/**
+ * the busy loops of a load task
+ */
+#define BENCHMARK_WORK 200
+
+#define BENCHMARK_MAXLOAD 16
+
+static Task* benchmark_load[BENCHMARK_MAXLOAD];
+static uint8_t benchmark_loadTasks = 0;
+
+static uint64_t benchmark_interruptAt = 0;
+static BenchmarkLatency benchmark_callbackLatency;
+static BenchmarkLatency benchmark_taskLatency;
+
+static void loadTask()
+{
+    Benchmark_work(BENCHMARK_WORK);
+}
+
+static void expiredCallback(void* argument)
+{
+    Benchmark_latencyRecord(&benchmark_callbackLatency, Benchmark_now() - benchmark_interruptAt);
+}
+
+static void expiredTask()
+{
+    Benchmark_latencyRecord(&benchmark_taskLatency, Benchmark_now() - benchmark_interruptAt);
+}
+
+static void timerISR()
+{
+    uint8_t i;
+
+    benchmark_interruptAt = Benchmark_now();
+    Task_resetDelayState();
+    for (i=0; i<benchmark_loadTasks; i++)
+    {
+        scheduleTask(benchmark_load[i]);
+    }
+    Timer_ISR();
+}
+
+/**
+ * runs the scheduler with the load tasks and prints one line
+ * @param loadTasks: the number of load tasks
+ */
+static void run(uint8_t loadTasks)
+{
+    uint8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    timers_size = 0;
+    Timer_initOperation();
+
+    benchmark_loadTasks = loadTasks;
+    for (i=0; i<loadTasks; i++)
+    {
+        benchmark_load[i] = addTask(1 + (i % 7), loadTask);
+    }
+    WaitTimer* timer = initWaitTimer(BENCHMARK_PERIOD);
+    setTimerCyclic(timer);
+    setTaskOnStop(timer, addTask(0, expiredTask));
+    setCallbackOnStop(timer, expiredCallback, 0);
+    setTimer(timer);
+
+    Benchmark_latencyReset(&benchmark_callbackLatency);
+    Benchmark_latencyReset(&benchmark_taskLatency);
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setTickLimit(BENCHMARK_TICKS);
+    enableScheduler();
+    scheduler();
+
+    printf("%10u  ", loadTasks);
+    Benchmark_latencyPrint(&benchmark_callbackLatency);
+    printf("  ");
+    Benchmark_latencyPrint(&benchmark_taskLatency);
+    printf("\n");
+}
+
+int main()
+{
+    printf("latency from the timer interrupt to the reaction [us] min / avg / max\n");
+    printf("%10s  %26s  %26s\n", "load tasks", "callback", "task on stop");
+    run(0);
+    run(4);
+    run(BENCHMARK_MAXLOAD);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * TimerLayoutBenchmark.c
+ *
+ * host benchmark of the WaitTimer layouts: packed (12 Bit and exponent),
+ * WAITTIMER_WIDE16 and WAITTIMER_WIDE32. Reports the RAM of the timers,
+ * the cost of one tick of the waitScheduler and the expiry tick of
+ * long one-shot timers (the packed layout rounds them down)
+ *
+ * the RAM is sizeof(WaitTimer) on the host. The host aligns the 32 Bit
+ * fields to 4 Bytes, the MSP430 to 2 Bytes: there WAITTIMER_WIDE32 takes 12 Bytes
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "Benchmark.h"
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the ticks of one run
+ */
+#define BENCHMARK_TICKS 200000UL
+
+/**
+ * resets the timers
+ */
+static void reset()
+{
+    host_reset();
+    timers_size = 0;
+    Timer_initOperation();
+}
+
+/**
+ * @return nanoseconds per tick with MAXTIMERS active cyclic timers
+ */
+static double tickCost()
+{
+    int8_t i;
+    uint32_t tick;
+
+    reset();
+    for (i=0; i<MAXTIMERS; i++)
+    {
+        WaitTimer* timer = initWaitTimer(100 + i);
+        setTimerCyclic(timer);
+        setTimer(timer);
+    }
+
+    uint64_t start = Benchmark_now();
+    for (tick=0; tick<BENCHMARK_TICKS; tick++)
+    {
+        Timer_ISR();
+    }
+    return (double)(Benchmark_now() - start) / BENCHMARK_TICKS;
+}
+
+/**
+ * @param waitTime: the wait time of a one-shot timer
+ * @return the number of ticks until it expired
+ */
+static uint32_t expiry(waittime_t waitTime)
+{
+    uint32_t tick = 0;
+
+    reset();
+    WaitTimer* timer = initWaitTimer(waitTime);
+    setTimer(timer);
+    while ((timer->status & WaitTimer_isActive) && tick < 2 * BENCHMARK_TICKS)
+    {
+        Timer_ISR();
+        tick += 1;
+    }
+    return tick;
+}
+
+int main()
+{
+    printf("layout: %s, backend: %s\n",
+#if defined WAITTIMER_WIDE32
+           "WAITTIMER_WIDE32",
+#elif defined WAITTIMER_WIDE16
+           "WAITTIMER_WIDE16",
+#else
+           "packed",
+#endif
+#ifdef WAITTIMER_WHEEL
+           "timing wheel"
+#else
+           "linear scan"
+#endif /* WAITTIMER_WHEEL */
+           );
+    printf("  RAM:              %u Bytes per timer, %u Bytes for %d timers\n",
+           (unsigned int)sizeof(WaitTimer), (unsigned int)sizeof(waitTimers_mem), MAXTIMERS);
+    printf("  tick:             %.1f ns with %d active timers\n", tickCost(), MAXTIMERS);
+    printf("  expiry of 4095:   tick %lu\n", (unsigned long)expiry(4095));
+    printf("  expiry of 5001:   tick %lu\n", (unsigned long)expiry(5001));
+    printf("  expiry of 65535:  tick %lu\n", (unsigned long)expiry(65535));
+#ifdef WAITTIMER_WIDE32
+    printf("  expiry of 100000: tick %lu\n", (unsigned long)expiry(100000));
+#else
+    printf("  expiry of 100000: not representable\n");
+#endif /* WAITTIMER_WIDE32 */
+    return 0;
+}
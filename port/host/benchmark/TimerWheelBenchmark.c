@@ -0,0 +1,99 @@
+/*
+ * TimerWheelBenchmark.c
+ *
+ * host benchmark of the cost of one tick of the waitScheduler with the
+ * linear scan and with the timing wheel (WAITTIMER_WHEEL) for 16, 64 and 127 timers
+ * (the timer numbers are int8_t, MAXTIMERS is limited to 127)
+ *
+ * all active: every timer is cyclic and active, the periods are 100 to 100 + n ticks
+ * 4 active:   all timers are initialized, 4 of them are active
+ *
+ * Timer_ISR() is called directly, the timers schedule no tasks
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include <stdio.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "Benchmark.h"
+
+#if MAXTIMERS < 127
+#error "build with -DMAXTIMERS=127"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the ticks of one run
+ */
+#define BENCHMARK_TICKS 200000UL
+
+/**
+ * runs the ticks
+ * @param timers: the number of timers
+ * @param active: the number of active timers
+ * @return nanoseconds per tick
+ */
+static double run(int8_t timers, int8_t active)
+{
+    int8_t i;
+    uint32_t tick;
+
+    host_reset();
+    timers_size = 0;
+    Timer_initOperation();
+
+    for (i=0; i<timers; i++)
+    {
+        WaitTimer* timer = initWaitTimer(100 + i);
+        setTimerCyclic(timer);
+        if (i < active)
+        {
+            setTimer(timer);
+        }
+    }
+
+    uint64_t start = Benchmark_now();
+    for (tick=0; tick<BENCHMARK_TICKS; tick++)
+    {
+        Timer_ISR();
+    }
+    uint64_t duration = Benchmark_now() - start;
+
+    return (double)duration / BENCHMARK_TICKS;
+}
+
+int main()
+{
+    static const int8_t timers[] = {16, 64, 127};
+    uint8_t i;
+
+    printf("waitScheduler: %s\n",
+#ifdef WAITTIMER_WHEEL
+           "timing wheel"
+#else
+           "linear scan"
+#endif /* WAITTIMER_WHEEL */
+           );
+    printf("%7s %20s %20s\n", "timers", "all active [ns/tick]", "4 active [ns/tick]");
+    for (i=0; i<sizeof(timers); i++)
+    {
+        double all = run(timers[i], timers[i]);
+        double few = run(timers[i], 4);
+        printf("%7d %20.1f %20.1f\n", timers[i], all, few);
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+/*
+ * ButtonSPITest.c
+ *
+ * host test of the buttons and the SPI operation on the interrupt paths of
+ * the host port: a bouncing button press is debounced by the button wait
+ * scheduler, its release task starts an SPI transfer, the USCI interrupt
+ * shifts the bytes through an SPI slave while the strobe (chip select) is held
+ *
+ * the user is simulated by a cyclic WaitTimer: it presses the button on its
+ * first expiry and releases it on expiry TEST_RELEASE, the pin bounces both times
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "input/Buttons.h"
+#include "SerialInterface/SPIOperation.h"
+#include "Test.h"
+
+#if !defined MAXBUTTONS || !defined MAXSHIFTREGISTER || !defined MAXBUFFER_VOID
+#error "build with MAXBUTTONS, MAXSHIFTREGISTER and MAXBUFFER_VOID"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+int8_t buttons_size = 0;
+Button buttons_mem[MAXBUTTONS];
+
+int8_t spiOperation_size = 0;
+SPIOperation spiOperation_mem[MAXSHIFTREGISTER];
+
+#define TEST_BUTTONPIN 0x08
+#define TEST_STROBEPIN 0x01
+
+/**
+ * the debounce time of the button in ticks
+ */
+#define TEST_DEBOUNCE 4
+
+/**
+ * the expiry of the user timer (every 5 ticks) the button is released on
+ */
+#define TEST_RELEASE 6
+
+#define TEST_BYTES 3
+
+static const uint8_t test_sent[TEST_BYTES] = {0x11, 0x22, 0x33};
+static uint8_t test_data[TEST_BYTES];
+static uint8_t test_slaveReceived[TEST_BYTES];
+static uint8_t test_slaveBytes = 0;
+static uint8_t test_strobeHeld = 0;
+
+static WaitTimer* test_user = 0;
+static Button* test_button = 0;
+static SPIOperation* test_operation = 0;
+static uint8_t test_userSteps = 0;
+static uint8_t test_transfers = 0;
+
+/**
+ * answers every byte inverted, records the bytes and the level of the strobe
+ */
+static uint8_t spiSlave(uint8_t byte)
+{
+    if (test_slaveBytes < TEST_BYTES)
+    {
+        test_slaveReceived[test_slaveBytes] = byte;
+    }
+    test_slaveBytes += 1;
+    if (!(P2OUT & TEST_STROBEPIN))
+    {
+        test_strobeHeld += 1;
+    }
+    return ~byte;
+}
+
+static void timerISR()
+{
+    Task_resetDelayState();
+    Timer_ISR();
+}
+
+static void portISR()
+{
+    if (P1IFG & TEST_BUTTONPIN)
+    {
+        P1IFG &= ~TEST_BUTTONPIN;
+        buttonPressed(test_button);
+    }
+}
+
+static void usciISR()
+{
+    if (host_USCIIFG & HOST_USCI_RXIFG)
+    {
+        SPI_nextByte_ISR_read();
+    }
+    else if (SPI_nextByte_ISR_write() == -1)
+    {
+        USCI_enable_TXIFG(0);
+    }
+}
+
+/**
+ * sets the pin to the level, bouncing once
+ */
+static void bounce(uint8_t level)
+{
+    host_setPin(&P1IN, TEST_BUTTONPIN, level);
+    host_setPin(&P1IN, TEST_BUTTONPIN, !level);
+    host_setPin(&P1IN, TEST_BUTTONPIN, level);
+}
+
+static void userTask()
+{
+    test_userSteps += 1;
+    if (test_userSteps == 1)
+    {
+        bounce(0);
+    }
+    else if (test_userSteps == TEST_RELEASE)
+    {
+        bounce(1);
+        haltTimer(test_user);
+    }
+}
+
+static void transferTask()
+{
+    test_transfers += 1;
+    TEST_CHECK(SPI_activateSPIOperation(test_operation, TEST_BYTES) != -1);
+}
+
+/**
+ * sets up the button, the SPI operation and the user, runs the scheduler for 100 ticks
+ * @param operationMode: the operation mode of the SPI operation
+ */
+static void run(uint8_t operationMode)
+{
+    uint8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    timers_size = 0;
+    buttons_size = 0;
+    spiOperation_size = 0;
+    buffer_size = 0;
+    test_slaveBytes = 0;
+    test_strobeHeld = 0;
+    test_userSteps = 0;
+    test_transfers = 0;
+    for (i=0; i<TEST_BYTES; i++)
+    {
+        test_data[i] = test_sent[i];
+    }
+
+    Timer_initOperation();
+    initButtonOperation(1);
+    SPI_initOperation(&host_USCITXBUF, &host_USCIRXBUF);
+
+    P2OUT |= TEST_STROBEPIN;
+    Buffer_void* buffer = initBuffer(test_data, TEST_BYTES, BUFFER_TYPE_REGULAR);
+    test_operation = SPI_initSPIOperation(TEST_STROBEPIN, &P2OUT, buffer, operationMode);
+
+    P1IES |= TEST_BUTTONPIN;
+    test_button = initButton(TEST_BUTTONPIN, &P1IN, TEST_DEBOUNCE);
+    addTaskOnReleaseToButton(test_button, addTask(1, transferTask));
+    setPortInterrupt(&P1IN, TEST_BUTTONPIN, 1);
+
+    test_user = initWaitTimer(5);
+    setTimerCyclic(test_user);
+    setTaskOnStop(test_user, addTask(1, userTask));
+    setTimer(test_user);
+
+    host_setSPISlave(spiSlave);
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    host_setInterruptHandler(HOST_IRQ_PORT1, portISR);
+    host_setInterruptHandler(HOST_IRQ_USCI, usciISR);
+    host_setTickLimit(100);
+    enableScheduler();
+    scheduler();
+}
+
+/**
+ * the bytes received overwrite the buffer
+ */
+static void testReadWrite()
+{
+    uint8_t i;
+
+    run(STROBE_ON_TRANSFER | STROBE_POLARITY_LOW | SPI_READ | SPI_WRITE);
+
+    TEST_CHECK_EQUAL(TEST_RELEASE, test_userSteps);
+    TEST_CHECK_EQUAL(1, test_transfers);
+    TEST_CHECK_EQUAL(TEST_BYTES, test_slaveBytes);
+    TEST_CHECK_EQUAL(TEST_BYTES, test_strobeHeld);
+    for (i=0; i<TEST_BYTES; i++)
+    {
+        TEST_CHECK_EQUAL(test_sent[i], test_slaveReceived[i]);
+        TEST_CHECK_EQUAL((uint8_t)~test_sent[i], test_data[i]);
+    }
+    TEST_CHECK_EQUAL(TEST_BYTES, test_operation->bytesReceived);
+    TEST_CHECK_EQUAL(TEST_STROBEPIN, P2OUT & TEST_STROBEPIN);
+    TEST_CHECK_EQUAL(-1, g_SPI_activeTransmission);
+    TEST_CHECK_EQUAL(0, test_button->status & Button_isActive);
+}
+
+/**
+ * write only: the buffer is not changed
+ */
+static void testWriteOnly()
+{
+    uint8_t i;
+
+    run(STROBE_ON_TRANSFER | STROBE_POLARITY_LOW | SPI_WRITE);
+
+    TEST_CHECK_EQUAL(1, test_transfers);
+    TEST_CHECK_EQUAL(TEST_BYTES, test_slaveBytes);
+    TEST_CHECK_EQUAL(TEST_BYTES, test_strobeHeld);
+    for (i=0; i<TEST_BYTES; i++)
+    {
+        TEST_CHECK_EQUAL(test_sent[i], test_slaveReceived[i]);
+        TEST_CHECK_EQUAL(test_sent[i], test_data[i]);
+    }
+    TEST_CHECK_EQUAL(TEST_STROBEPIN, P2OUT & TEST_STROBEPIN);
+    TEST_CHECK_EQUAL(-1, g_SPI_activeTransmission);
+}
+
+int main()
+{
+    testReadWrite();
+    testWriteOnly();
+    return Test_result();
+}
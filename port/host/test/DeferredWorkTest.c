@@ -0,0 +1,96 @@
+/*
+ * DeferredWorkTest.c
+ *
+ * host test of the DeferredWork queue in the scheduler: work posted by an
+ * interrupt while a task runs is done before the scheduler chooses the next task
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include "Task.h"
+#include "DeferredWork.h"
+#include "Test.h"
+
+#ifndef MAXDEFERREDWORK
+#error "build with -DMAXDEFERREDWORK"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+/**
+ * the order the tasks and the work ran in
+ */
+static char test_order[8];
+static uint8_t test_orderSize = 0;
+
+static void record(char c)
+{
+    if (test_orderSize < sizeof(test_order) - 1)
+    {
+        test_order[test_orderSize++] = c;
+        test_order[test_orderSize] = 0;
+    }
+}
+
+static void work(void* argument)
+{
+    record('w');
+}
+
+static void portISR()
+{
+    DeferredWork_post(work, 0);
+}
+
+/**
+ * the task of the higher priority, an interrupt posts work while it runs
+ */
+static void highTask()
+{
+    record('h');
+    host_raiseInterrupt(HOST_IRQ_PORT1);
+}
+
+static void lowTask()
+{
+    record('l');
+}
+
+/**
+ * work posted while a task runs is done before the next task
+ */
+static void testWorkBeforeNextTask()
+{
+    host_reset();
+    tasks_size = 0;
+    test_orderSize = 0;
+    test_order[0] = 0;
+    host_setInterruptHandler(HOST_IRQ_PORT1, portISR);
+
+    scheduleTask(addTask(1, lowTask));
+    scheduleTask(addTask(2, highTask));
+
+    host_setTickLimit(10);
+    enableScheduler();
+    scheduler();
+
+    TEST_CHECK_EQUAL('h', test_order[0]);
+    TEST_CHECK_EQUAL('w', test_order[1]);
+    TEST_CHECK_EQUAL('l', test_order[2]);
+    TEST_CHECK_EQUAL(3, test_orderSize);
+    TEST_CHECK(!DeferredWork_isPending());
+}
+
+int main()
+{
+    testWorkBeforeNextTask();
+    return Test_result();
+}
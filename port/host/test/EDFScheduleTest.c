@@ -0,0 +1,214 @@
+/*
+ * EDFScheduleTest.c
+ *
+ * host schedulability test of SCHEDULER_EDF: periodic task sets with the
+ * deadline equal to the period meet all deadlines if their utilization is
+ * at most 1, and miss deadlines if it is above 1
+ *
+ * a job of C ticks is a cyclic task of C cycles, every cycle takes one tick
+ * of virtual time. The scheduler chooses the task again after every cycle,
+ * so a job is preempted on tick boundaries. The timer interrupt posts the
+ * releases to DeferredWork, they are done before the next task is chosen
+ * (a release in the interrupt would find the task of the ending job active).
+ * a job is missed if its task is still active at the next release
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "DeferredWork.h"
+#include "Test.h"
+
+#ifndef SCHEDULER_EDF
+#error "build with -DSCHEDULER_EDF"
+#endif
+#ifndef MAXDEFERREDWORK
+#error "build with -DMAXDEFERREDWORK"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the ticks of one run, a multiple of the hyperperiods of all task sets
+ */
+#define TEST_TICKS 8400UL
+
+#define TEST_MAXTASKS 4
+
+/**
+ * Test task structure
+ * Fields:
+ *  cost: the ticks of one job, up to 16 (the cycles of a task)
+ *  period: the period and the relative deadline in ticks
+ */
+typedef struct TestTask_t {
+    uint8_t cost;
+    uint16_t period;
+    Task* task;
+} TestTask;
+
+static TestTask test_tasks[TEST_MAXTASKS];
+static uint8_t test_numberOfTasks = 0;
+static uint16_t test_misses = 0;
+static uint32_t test_busyTicks = 0;
+
+static void jobTask()
+{
+    test_busyTicks += 1;
+    host_advanceTime(1);
+}
+
+/**
+ * releases the next job of a task, posted by the timer interrupt
+ */
+static void release(void* argument)
+{
+    TestTask* testTask = (TestTask*) argument;
+    if (testTask->task->status & Task_isActive)
+    {
+        test_misses += 1;
+        return;
+    }
+    scheduleTask(testTask->task);
+}
+
+static void timerISR()
+{
+    uint8_t i;
+
+    Task_resetDelayState();
+    Timer_ISR();
+    if (rsos_tickCount >= TEST_TICKS)
+    {
+        disableScheduler();
+        return;
+    }
+    for (i=0; i<test_numberOfTasks; i++)
+    {
+        if (rsos_tickCount % test_tasks[i].period == 0)
+        {
+            DeferredWork_post(release, &test_tasks[i]);
+        }
+    }
+}
+
+/**
+ * runs a task set for TEST_TICKS ticks
+ * @param costs: the costs of the tasks
+ * @param periods: the periods of the tasks, 0 terminated
+ * @return the number of missed deadlines
+ */
+static uint16_t run(const uint8_t* costs, const uint16_t* periods)
+{
+    uint8_t i;
+
+    host_reset();
+    tasks_size = 0;
+    timers_size = 0;
+    rsos_tickCount = 0;
+    test_misses = 0;
+    test_busyTicks = 0;
+    deferredWork_overflows = 0;
+    Timer_initOperation();
+
+    for (i=0; periods[i] != 0; i++)
+    {
+        test_tasks[i].cost = costs[i];
+        test_tasks[i].period = periods[i];
+        // the priorities rise with the period: EDF must ignore them
+        test_tasks[i].task = addTask(i, jobTask);
+        setTaskCyclic(test_tasks[i].task, costs[i]);
+        setTaskDeadline(test_tasks[i].task, periods[i]);
+        scheduleTask(test_tasks[i].task);
+    }
+    test_numberOfTasks = i;
+
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+    enableScheduler();
+    scheduler();
+
+    TEST_CHECK_EQUAL(0, deferredWork_overflows);
+    return test_misses;
+}
+
+/**
+ * @return the ticks of work of a task set in TEST_TICKS ticks
+ */
+static uint32_t work(const uint8_t* costs, const uint16_t* periods)
+{
+    uint32_t ticks = 0;
+    uint8_t i;
+    for (i=0; periods[i] != 0; i++)
+    {
+        ticks += TEST_TICKS / periods[i] * costs[i];
+    }
+    return ticks;
+}
+
+/**
+ * utilization 0.97, not schedulable with rate monotonic priorities
+ */
+static void testBelowOne()
+{
+    static const uint8_t costs[] = {2, 4};
+    static const uint16_t periods[] = {5, 7, 0};
+
+    TEST_CHECK_EQUAL(0, run(costs, periods));
+    TEST_CHECK_EQUAL(work(costs, periods), test_busyTicks);
+}
+
+/**
+ * utilization 0.96 with three tasks
+ */
+static void testThreeTasks()
+{
+    static const uint8_t costs[] = {1, 2, 3};
+    static const uint16_t periods[] = {4, 6, 8, 0};
+
+    TEST_CHECK_EQUAL(0, run(costs, periods));
+    TEST_CHECK_EQUAL(work(costs, periods), test_busyTicks);
+}
+
+/**
+ * utilization 1, the processor is never idle
+ */
+static void testFullUtilization()
+{
+    static const uint8_t costs[] = {2, 3};
+    static const uint16_t periods[] = {4, 6, 0};
+
+    TEST_CHECK_EQUAL(0, run(costs, periods));
+    TEST_CHECK_EQUAL(TEST_TICKS, test_busyTicks);
+}
+
+/**
+ * utilization 1.03, deadlines are missed
+ */
+static void testAboveOne()
+{
+    static const uint8_t costs[] = {1, 2, 3};
+    static const uint16_t periods[] = {3, 5, 10, 0};
+
+    TEST_CHECK(run(costs, periods) > 0);
+}
+
+int main()
+{
+    testBelowOne();
+    testThreeTasks();
+    testFullUtilization();
+    testAboveOne();
+    return Test_result();
+}
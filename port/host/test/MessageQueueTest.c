@@ -0,0 +1,138 @@
+/*
+ * MessageQueueTest.c
+ *
+ * host test of the consumer wakeup of the MessageQueue: a message committed
+ * by an interrupt after the last MessageQueue_peek() of the consumer, while the
+ * consumer task still runs, is taken by a further run of the consumer
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include "Task.h"
+#include "buffer/MessageQueue.h"
+#include "Test.h"
+
+#ifndef MAXMESSAGEQUEUES
+#error "build with -DMAXMESSAGEQUEUES"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+#define TEST_MESSAGES 4
+
+static uint16_t test_data[TEST_MESSAGES];
+static MessageQueue* test_queue = 0;
+static uint16_t test_received = 0;
+static uint16_t test_lastMessage = 0;
+static uint8_t test_interruptCommits = 0;
+
+/**
+ * commits a message, once
+ */
+static void portISR()
+{
+    uint16_t* message = (uint16_t*) MessageQueue_reserve(test_queue);
+    if (message != 0)
+    {
+        *message = 0x1234;
+        MessageQueue_commit(test_queue);
+    }
+}
+
+/**
+ * takes all messages, then the interrupt commits a message before the task returns
+ */
+static void consumerTask()
+{
+    uint16_t* message;
+    while ((message = (uint16_t*) MessageQueue_peek(test_queue)) != 0)
+    {
+        test_lastMessage = *message;
+        test_received += 1;
+        MessageQueue_release(test_queue);
+    }
+    if (test_interruptCommits != 0)
+    {
+        test_interruptCommits -= 1;
+        host_raiseInterrupt(HOST_IRQ_PORT1);
+    }
+}
+
+/**
+ * resets the tasks, the buffers and the queues
+ */
+static void reset()
+{
+    host_reset();
+    tasks_size = 0;
+    buffer_size = 0;
+    messageQueue_size = 0;
+    test_received = 0;
+    test_lastMessage = 0;
+    initMessageQueueOperation();
+    host_setInterruptHandler(HOST_IRQ_PORT1, portISR);
+}
+
+/**
+ * the message committed while the consumer runs is received without a further commit
+ */
+static void testCommitWhileConsumerRuns()
+{
+    reset();
+    test_queue = initMessageQueue(test_data, TEST_MESSAGES, sizeof(uint16_t), addTask(1, consumerTask));
+    test_interruptCommits = 1;
+
+    uint16_t* message = (uint16_t*) MessageQueue_reserve(test_queue);
+    *message = 0x0001;
+    MessageQueue_commit(test_queue);
+
+    host_setTickLimit(10);
+    enableScheduler();
+    scheduler();
+
+    TEST_CHECK_EQUAL(2, test_received);
+    TEST_CHECK_EQUAL(0x1234, test_lastMessage);
+    TEST_CHECK_EQUAL(0, MessageQueue_getCount(test_queue));
+}
+
+/**
+ * two queues with the same consumer add the check task once
+ */
+static void testTwoQueuesOneConsumer()
+{
+    reset();
+    Task* consumer = addTask(1, consumerTask);
+    initMessageQueue(test_data, TEST_MESSAGES / 2, sizeof(uint16_t), consumer);
+    initMessageQueue(&test_data[TEST_MESSAGES / 2], TEST_MESSAGES / 2, sizeof(uint16_t), consumer);
+
+    TEST_CHECK_EQUAL(1, (consumer->status & followUpNumberMask) >> 12);
+    TEST_CHECK(consumer->followUpTask[0] == task_messageQueueCheck);
+}
+
+/**
+ * a commit without a reserved message is rejected
+ */
+static void testCommitWithoutReserve()
+{
+    reset();
+    test_queue = initMessageQueue(test_data, TEST_MESSAGES, sizeof(uint16_t), 0);
+
+    TEST_CHECK_EQUAL((uint8_t)RSOS_ret_ERROR, (uint8_t)MessageQueue_commit(test_queue));
+    TEST_CHECK_EQUAL(0, MessageQueue_getCount(test_queue));
+}
+
+int main()
+{
+    testCommitWhileConsumerRuns();
+    testTwoQueuesOneConsumer();
+    testCommitWithoutReserve();
+    return Test_result();
+}
@@ -0,0 +1,128 @@
+/*
+ * RTCAlarmTest.c
+ *
+ * host test of the periodic RTC alarms: after the clock is set far ahead,
+ * a periodic alarm is scheduled once and moved after the current second
+ * by RTC_setSeconds(), the interrupt does not catch up the missed periods.
+ * built with a 1 kHz tick (RTC_TICKSPERSECOND above 255)
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include "Task.h"
+#include "RTC.h"
+#include "Test.h"
+
+#ifndef MAXRTCALARMS
+#error "build with -DMAXRTCALARMS"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+/**
+ * the alarm is due on second 10 and repeated every minute
+ */
+#define TEST_ALARMTIME 10
+#define TEST_PERIOD RTC_PERIOD_MINUTELY
+
+/**
+ * the seconds the clock is set to, about one year after the alarm
+ */
+#define TEST_NOW 31536000UL
+
+/**
+ * runs the clock one second
+ */
+static void second()
+{
+    uint16_t i;
+    for (i=0; i<RTC_TICKSPERSECOND; i++)
+    {
+        RTC_tick();
+    }
+}
+
+static void emptyTask()
+{
+}
+
+/**
+ * resets the tasks and the clock
+ * @return the task of the alarm
+ */
+static Task* reset()
+{
+    host_reset();
+    tasks_size = 0;
+    rtcAlarm_size = 0;
+    RTC_initOperation();
+    return addTask(0, emptyTask);
+}
+
+/**
+ * the clock is set ahead of a periodic alarm
+ */
+static void testSetSecondsAhead()
+{
+    Task* task = reset();
+    RTC_Alarm* alarm = RTC_initAlarm(task);
+    RTC_setAlarm(alarm, TEST_ALARMTIME, TEST_PERIOD);
+
+    RTC_setSeconds(TEST_NOW);
+    // the last due time, not one period after the original time
+    TEST_CHECK_EQUAL(TEST_NOW - (TEST_NOW - TEST_ALARMTIME) % TEST_PERIOD, alarm->time);
+
+    second();
+    TEST_CHECK(task->status & Task_isActive);
+    // one period after the last due time, after the current second
+    TEST_CHECK_EQUAL(TEST_NOW - (TEST_NOW - TEST_ALARMTIME) % TEST_PERIOD + TEST_PERIOD, alarm->time);
+    TEST_CHECK(alarm->time > RTC_getSeconds());
+}
+
+/**
+ * a periodic alarm is set to a time in the past
+ */
+static void testSetAlarmInPast()
+{
+    Task* task = reset();
+    RTC_Alarm* alarm = RTC_initAlarm(task);
+    RTC_setSeconds(TEST_NOW);
+    RTC_setAlarm(alarm, TEST_ALARMTIME, TEST_PERIOD);
+
+    second();
+    TEST_CHECK(task->status & Task_isActive);
+    TEST_CHECK(alarm->time > RTC_getSeconds());
+    TEST_CHECK(alarm->time <= RTC_getSeconds() + TEST_PERIOD);
+}
+
+/**
+ * a one-shot alarm in the past keeps its time and is due with the next second
+ */
+static void testOneShotInPast()
+{
+    Task* task = reset();
+    RTC_Alarm* alarm = RTC_initAlarm(task);
+    RTC_setSeconds(TEST_NOW);
+    RTC_setAlarm(alarm, TEST_ALARMTIME, 0);
+    TEST_CHECK_EQUAL(TEST_ALARMTIME, alarm->time);
+
+    second();
+    TEST_CHECK(task->status & Task_isActive);
+    TEST_CHECK(!alarm->isActive);
+}
+
+int main()
+{
+    testSetSecondsAhead();
+    testSetAlarmInPast();
+    testOneShotInPast();
+    return Test_result();
+}
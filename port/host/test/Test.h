@@ -0,0 +1,59 @@
+/*
+ * Test.h
+ *
+ * checks of the host tests: a failed check is printed with its line,
+ * Test_result() is the exit code of the test program
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+/**
+ * the number of failed checks
+ */
+static int test_failures = 0;
+
+/**
+ * checks a condition, prints it if it is false
+ */
+#define TEST_CHECK(_condition) \
+    do { \
+        if (!(_condition)) \
+        { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_condition); \
+            test_failures += 1; \
+        } \
+    } while (0)
+
+/**
+ * checks two unsigned values for equality, prints both if they differ
+ */
+#define TEST_CHECK_EQUAL(_expected, _actual) \
+    do { \
+        unsigned long _e = (unsigned long)(_expected); \
+        unsigned long _a = (unsigned long)(_actual); \
+        if (_e != _a) \
+        { \
+            printf("%s:%d: check failed: %s == %s (%lu != %lu)\n", \
+                   __FILE__, __LINE__, #_expected, #_actual, _e, _a); \
+            test_failures += 1; \
+        } \
+    } while (0)
+
+/**
+ * prints the result
+ * @return 0 if all checks passed, 1 otherwise
+ */
+static inline int Test_result() __attribute__((always_inline));
+static inline int Test_result()
+{
+    printf("%s\n", (test_failures == 0) ? "passed" : "FAILED");
+    return (test_failures == 0) ? 0 : 1;
+}
+
+#endif /* TEST_H_ */
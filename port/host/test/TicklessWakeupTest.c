@@ -0,0 +1,174 @@
+/*
+ * TicklessWakeupTest.c
+ *
+ * host test of Timer_setNextWakeup() (WAITTIMER_TICKLESS): after a task ran
+ * longer than the time to the next expiry, the wakeup lies in the past.
+ * it must be requested for the next tick, a compare match timer would
+ * only reach a tick in the past after the counter wrapped.
+ * a timer or periodic task started by a long task counts from the tick it
+ * is started on, not from the last tick processed by the waitScheduler
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <HardwareAdaptionLayer.h>
+#include <RSOSDefines.h>
+
+#include "Task.h"
+#include "WaitTimer.h"
+#include "Test.h"
+
+#ifndef WAITTIMER_TICKLESS
+#error "build with -DWAITTIMER_TICKLESS"
+#endif
+#ifndef MAXPERIODICTASKS
+#error "build with -DMAXPERIODICTASKS"
+#endif
+
+signed char tasks_size = 0;
+Task task_mem[MAXTASKS];
+int8_t currentRunningTask = -1;
+uint8_t currentPriority = 0;
+uint8_t numberOfRunningTasks = 0;
+
+int8_t timers_size = 0;
+WaitTimer waitTimers_mem[MAXTIMERS];
+
+/**
+ * the ticks a long task runs
+ */
+#define TEST_LONGRUN 1000
+
+/**
+ * the phase and the period of the periodic task
+ */
+#define TEST_PHASE 10
+#define TEST_PERIOD 100
+
+static WaitTimer* test_timer = 0;
+static PeriodicTask* test_periodicTask = 0;
+static uint32_t test_ranAt = 0;
+
+static void timerISR()
+{
+    Task_resetDelayState();
+    Timer_ISR();
+}
+
+/**
+ * starts the timer and runs longer than its wait time
+ */
+static void longTimerTask()
+{
+    setTimer(test_timer);
+    host_advanceTime(TEST_LONGRUN);
+}
+
+static void longTask()
+{
+    host_advanceTime(TEST_LONGRUN);
+}
+
+/**
+ * runs long and starts the periodic task at its end
+ */
+static void longPeriodicTask()
+{
+    host_advanceTime(TEST_LONGRUN);
+    PeriodicTask_start(test_periodicTask, TEST_PHASE);
+}
+
+/**
+ * records the tick of the first run
+ */
+static void recordTask()
+{
+    if (test_ranAt == 0)
+    {
+        test_ranAt = host_virtualTicks;
+    }
+}
+
+/**
+ * resets the port and the modules, the virtual time continues
+ */
+static void reset()
+{
+    uint32_t now = host_virtualTicks;
+    host_reset();
+    host_virtualTicks = now;
+    tasks_size = 0;
+    timers_size = 0;
+    periodicTask_size = 0;
+    test_ranAt = 0;
+    Timer_initOperation();
+    host_setInterruptHandler(HOST_IRQ_TIMER, timerISR);
+}
+
+/**
+ * a timer expires while the task that started it still runs
+ */
+static void testTimerExpiredDuringTask()
+{
+    reset();
+    uint32_t start = host_virtualTicks;
+
+    test_timer = initWaitTimer(TEST_LONGRUN / 2);
+    setTaskOnStop(test_timer, addTask(1, recordTask));
+    scheduleTask(addTask(0, longTimerTask));
+
+    host_setTickLimit(start + 4 * TEST_LONGRUN);
+    enableScheduler();
+    scheduler();
+
+    // the expiry is found on the first tick after the task
+    TEST_CHECK_EQUAL(start + TEST_LONGRUN + 1, test_ranAt);
+}
+
+/**
+ * a delayed task waits for the next tick while another task runs long
+ */
+static void testDelayedTaskAfterLongTask()
+{
+    reset();
+    uint32_t start = host_virtualTicks;
+
+    Task* delayed = addTask(0, recordTask);
+    setTaskDelay(delayed, 1);
+    scheduleTask(delayed);
+    scheduleTask(addTask(0, longTask));
+
+    host_setTickLimit(start + 4 * TEST_LONGRUN);
+    enableScheduler();
+    scheduler();
+
+    TEST_CHECK_EQUAL(start + TEST_LONGRUN + 1, test_ranAt);
+}
+
+/**
+ * a periodic task started at the end of a long task is released
+ * the phase after the start
+ */
+static void testPeriodicTaskStartedByLongTask()
+{
+    reset();
+    uint32_t start = host_virtualTicks;
+
+    test_periodicTask = initPeriodicTask(addTask(1, recordTask), TEST_PERIOD);
+    scheduleTask(addTask(0, longPeriodicTask));
+
+    host_setTickLimit(start + 4 * TEST_LONGRUN);
+    enableScheduler();
+    scheduler();
+
+    TEST_CHECK_EQUAL(start + TEST_LONGRUN + TEST_PHASE, test_ranAt);
+}
+
+int main()
+{
+    testTimerExpiredDuringTask();
+    testDelayedTaskAfterLongTask();
+    testPeriodicTaskStartedByLongTask();
+    return Test_result();
+}
@@ -0,0 +1,239 @@
+/*
+ * TraceToJson.c
+ *
+ * host tool: converts a dump of the trace recorder (Trace_dump(), @see Trace.h)
+ * to the Chrome trace event format, to be opened in chrome://tracing or ui.perfetto.dev
+ *
+ * build:   cc -std=c99 -o TraceToJson TraceToJson.c
+ * usage:   TraceToJson [-t microseconds per counter tick] [dump file] > trace.json
+ *          the dump is read from stdin if no file is given
+ *
+ * the timestamps of the dump are 16 Bit, two following events must not be more
+ * than one counter period apart (a periodic task or the timer events assure this)
+ *
+ * threads of the trace:
+ *  1: scheduler (tasks, idle time, waitScheduler, buttonWaitScheduler)
+ *  2: SPI transfers
+ *  3: I2C transfers
+ *
+ *  Created on: 18.10.2026
+ *      Author: Richard
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* event types, as in Trace.h */
+#define TRACE_TASK_SCHEDULED 0x01
+#define TRACE_TASK_BEGIN 0x02
+#define TRACE_TASK_END 0x03
+#define TRACE_IDLE_BEGIN 0x04
+#define TRACE_IDLE_END 0x05
+#define TRACE_TIMER_BEGIN 0x06
+#define TRACE_TIMER_END 0x07
+#define TRACE_TIMER_EXPIRED 0x08
+#define TRACE_BUTTONS_BEGIN 0x09
+#define TRACE_BUTTONS_END 0x0A
+#define TRACE_SPI_BEGIN 0x0B
+#define TRACE_SPI_END 0x0C
+#define TRACE_I2C_BEGIN 0x0D
+#define TRACE_I2C_END 0x0E
+#define TRACE_I2C_ERROR 0x0F
+#define TRACE_TASK_OVERRUN 0x10
+#define TRACE_USER 0x80
+
+#define THREAD_SCHEDULER 1
+#define THREAD_SPI 2
+#define THREAD_I2C 3
+#define THREADS 4
+
+/**
+ * the number of open durations per thread, an end without begin
+ * (the begin was overwritten in the ring) is not written
+ */
+static int openDurations[THREADS];
+
+static int firstEvent = 1;
+
+static void writeEvent(const char* phase, int thread, double time, const char* name, int data)
+{
+    if (phase[0] == 'E')
+    {
+        if (openDurations[thread] == 0)
+        {
+            return;
+        }
+        openDurations[thread] -= 1;
+    }
+    else if (phase[0] == 'B')
+    {
+        openDurations[thread] += 1;
+    }
+
+    printf("%s\n  {\"ph\": \"%s\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"name\": \"%s\"",
+           firstEvent ? "" : ",", phase, thread, time, name);
+    if (phase[0] == 'i')
+    {
+        printf(", \"s\": \"t\"");
+    }
+    if (data >= 0)
+    {
+        printf(", \"args\": {\"data\": %d}", data);
+    }
+    printf("}");
+    firstEvent = 0;
+}
+
+static void writeThreadName(int thread, const char* name)
+{
+    printf("%s\n  {\"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"name\": \"thread_name\", \"args\": {\"name\": \"%s\"}}",
+           firstEvent ? "" : ",", thread, name);
+    firstEvent = 0;
+}
+
+static int read16(FILE* in, unsigned int* value)
+{
+    int low = fgetc(in);
+    int high = fgetc(in);
+    if (low == EOF || high == EOF)
+    {
+        return -1;
+    }
+    *value = (unsigned int)low | ((unsigned int)high << 8);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    double microsecondsPerTick = 1.0;
+    const char* fileName = 0;
+    FILE* in = stdin;
+    int i;
+
+    for (i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            microsecondsPerTick = atof(argv[++i]);
+        }
+        else
+        {
+            fileName = argv[i];
+        }
+    }
+    if (fileName != 0)
+    {
+        in = fopen(fileName, "rb");
+        if (in == 0)
+        {
+            fprintf(stderr, "can not open %s\n", fileName);
+            return 1;
+        }
+    }
+
+    char magic[4];
+    int version, counterSize;
+    unsigned int number, overwritten;
+    if (fread(magic, 1, 4, in) != 4 || memcmp(magic, "RSTR", 4) != 0)
+    {
+        fprintf(stderr, "no trace dump\n");
+        return 1;
+    }
+    version = fgetc(in);
+    counterSize = fgetc(in);
+    if (version != 1 || counterSize != 2 || read16(in, &number) || read16(in, &overwritten))
+    {
+        fprintf(stderr, "unknown trace dump version\n");
+        return 1;
+    }
+    fprintf(stderr, "%u events, %u overwritten\n", number, overwritten);
+
+    printf("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    writeThreadName(THREAD_SCHEDULER, "scheduler");
+    writeThreadName(THREAD_SPI, "SPI");
+    writeThreadName(THREAD_I2C, "I2C");
+
+    uint64_t ticks = 0;
+    unsigned int lastTimestamp = 0;
+    unsigned int n;
+    for (n=0; n<number; n++)
+    {
+        unsigned int timestamp;
+        int type, data;
+        char name[32];
+
+        if (read16(in, &timestamp) || (type = fgetc(in)) == EOF || (data = fgetc(in)) == EOF)
+        {
+            fprintf(stderr, "dump ends after %u events\n", n);
+            break;
+        }
+        if (n != 0)
+        {
+            ticks += (uint16_t)(timestamp - lastTimestamp);     // the counter wraps around
+        }
+        lastTimestamp = timestamp;
+        double time = ticks * microsecondsPerTick;
+
+        switch (type)
+        {
+        case TRACE_TASK_SCHEDULED:
+            snprintf(name, sizeof(name), "schedule task %d", data);
+            writeEvent("i", THREAD_SCHEDULER, time, name, -1);
+            break;
+        case TRACE_TASK_BEGIN:
+        case TRACE_TASK_END:
+            snprintf(name, sizeof(name), "task %d", data);
+            writeEvent(type == TRACE_TASK_BEGIN ? "B" : "E", THREAD_SCHEDULER, time, name, -1);
+            break;
+        case TRACE_IDLE_BEGIN:
+        case TRACE_IDLE_END:
+            writeEvent(type == TRACE_IDLE_BEGIN ? "B" : "E", THREAD_SCHEDULER, time, "idle", -1);
+            break;
+        case TRACE_TIMER_BEGIN:
+        case TRACE_TIMER_END:
+            writeEvent(type == TRACE_TIMER_BEGIN ? "B" : "E", THREAD_SCHEDULER, time, "waitScheduler", -1);
+            break;
+        case TRACE_TIMER_EXPIRED:
+            snprintf(name, sizeof(name), "timer %d expired", data);
+            writeEvent("i", THREAD_SCHEDULER, time, name, -1);
+            break;
+        case TRACE_TASK_OVERRUN:
+            snprintf(name, sizeof(name), "task %d overrun", data);
+            writeEvent("i", THREAD_SCHEDULER, time, name, -1);
+            break;
+        case TRACE_BUTTONS_BEGIN:
+        case TRACE_BUTTONS_END:
+            writeEvent(type == TRACE_BUTTONS_BEGIN ? "B" : "E", THREAD_SCHEDULER, time, "buttonWaitScheduler", -1);
+            break;
+        case TRACE_SPI_BEGIN:
+        case TRACE_SPI_END:
+            snprintf(name, sizeof(name), "SPI %d", data);
+            writeEvent(type == TRACE_SPI_BEGIN ? "B" : "E", THREAD_SPI, time, name, -1);
+            break;
+        case TRACE_I2C_BEGIN:
+        case TRACE_I2C_END:
+            snprintf(name, sizeof(name), "I2C %d", data);
+            writeEvent(type == TRACE_I2C_BEGIN ? "B" : "E", THREAD_I2C, time, name, -1);
+            break;
+        case TRACE_I2C_ERROR:
+            snprintf(name, sizeof(name), "I2C %d", data);
+            writeEvent("E", THREAD_I2C, time, name, -1);
+            writeEvent("i", THREAD_I2C, time, "I2C error", data);
+            break;
+        default:
+            snprintf(name, sizeof(name), type >= TRACE_USER ? "user 0x%02X" : "unknown 0x%02X", type);
+            writeEvent("i", THREAD_SCHEDULER, time, name, data);
+            break;
+        }
+    }
+
+    printf("\n]}\n");
+
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    return 0;
+}